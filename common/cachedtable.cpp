@@ -0,0 +1,372 @@
+#include <string>
+#include <vector>
+#include <poll.h>
+#include <string.h>
+#include <hiredis/hiredis.h>
+#include "logger.h"
+#include "dbconnector.h"
+#include "redisreply.h"
+#include "rediscommand.h"
+#include "table.h"
+#include "cachedtable.h"
+
+using namespace std;
+
+namespace swss {
+
+/* Keys per SCAN reply, their HGETALLs are pipelined in one round trip */
+static const int SCAN_BATCH_SIZE = 1000;
+
+CachedTable::CachedTable(DBConnector *db, const string &tableName, size_t maxEntries)
+    : Table(db, tableName)
+    , m_db(db)
+    , m_maxEntries(maxEntries)
+    , m_complete(true)
+    , m_maxStaleness(0)
+    , m_lastRefresh(chrono::steady_clock::now())
+    , m_hits(0)
+    , m_misses(0)
+{
+    m_keyspace = "__keyspace@";
+
+    m_keyspace += to_string(db->getDbId()) + "__:" + tableName + getTableNameSeparator() + "*";
+
+    /* Subscribe before loading, changes done meanwhile only invalidate
+     * what was just loaded */
+    psubscribe(m_db, m_keyspace);
+
+    load();
+}
+
+void CachedTable::load()
+{
+    SWSS_LOG_ENTER();
+
+    string pattern = getTableName() + getTableNameSeparator() + "*";
+    size_t prefixLen = getTableName().length() + getTableNameSeparator().length();
+    string cursor = "0";
+
+    do
+    {
+        RedisCommand scan;
+        scan.format("SCAN %s MATCH %s COUNT %d", cursor.c_str(), pattern.c_str(), SCAN_BATCH_SIZE);
+        RedisReply r(m_db, scan, REDIS_REPLY_ARRAY);
+        redisReply *reply = r.getContext();
+
+        if (reply->elements != 2)
+        {
+            SWSS_LOG_THROW("invalid SCAN reply for %s", pattern.c_str());
+        }
+
+        cursor = reply->element[0]->str;
+        redisReply *keys = reply->element[1];
+
+        for (size_t i = 0; i < keys->elements; i++)
+        {
+            RedisCommand hgetall;
+            hgetall.format("HGETALL %s", keys->element[i]->str);
+            redisAppendFormattedCommand(m_db->getContext(), hgetall.c_str(), hgetall.length());
+        }
+
+        for (size_t i = 0; i < keys->elements; i++)
+        {
+            redisReply *h = nullptr;
+            if (redisGetReply(m_db->getContext(), reinterpret_cast<void**>(&h)) != REDIS_OK)
+            {
+                throw runtime_error("Unable to read redis reply");
+            }
+
+            RedisReply hr(h);
+
+            /* Not a hash, skip it and keep reading the pipelined replies */
+            if (h->type != REDIS_REPLY_ARRAY)
+            {
+                SWSS_LOG_WARN("Skipping %s, HGETALL failed: %s", keys->element[i]->str,
+                              h->type == REDIS_REPLY_ERROR ? h->str : "unexpected reply");
+                continue;
+            }
+
+            /* Deleted since SCAN */
+            if (h->elements == 0)
+            {
+                continue;
+            }
+
+            vector<FieldValueTuple> values;
+            for (size_t j = 0; j + 1 < h->elements; j += 2)
+            {
+                values.push_back(make_pair(stripSpecialSym(h->element[j]->str),
+                                           h->element[j + 1]->str));
+            }
+
+            /* Remaining keys get fetched on demand */
+            if (m_maxEntries && m_cache.size() >= m_maxEntries)
+            {
+                m_complete = false;
+                continue;
+            }
+
+            store(string(keys->element[i]->str).substr(prefixLen), &values);
+        }
+    }
+    while (cursor != "0");
+
+    SWSS_LOG_NOTICE("Loaded %zu entries of %s%s", m_cache.size(),
+                    getTableName().c_str(), m_complete ? "" : " (partial)");
+}
+
+bool CachedTable::get(const string &key, vector<FieldValueTuple> &values)
+{
+    refresh();
+
+    auto it = m_cache.find(key);
+    if (it != m_cache.end())
+    {
+        touch(it);
+
+        if (it->second.valid)
+        {
+            m_hits++;
+            values = it->second.values;
+            return true;
+        }
+    }
+    else if (m_complete)
+    {
+        m_hits++;
+        values.clear();
+        return false;
+    }
+
+    m_misses++;
+
+    if (!Table::get(key, values))
+    {
+        erase(key);
+        return false;
+    }
+
+    store(key, &values);
+    return true;
+}
+
+void CachedTable::getKeys(vector<string> &keys)
+{
+    refresh();
+
+    if (!m_complete)
+    {
+        Table::getKeys(keys);
+        return;
+    }
+
+    keys.clear();
+    keys.reserve(m_cache.size());
+
+    for (const auto &entry: m_cache)
+    {
+        keys.push_back(entry.first);
+    }
+}
+
+void CachedTable::set(const string &key, const vector<FieldValueTuple> &values,
+                      const string &op, const string &prefix)
+{
+    Table::set(key, values, op, prefix);
+
+    /* Fields not in values are kept, refetch the whole entry */
+    auto it = m_cache.find(key);
+    if (it != m_cache.end())
+    {
+        it->second.valid = false;
+    }
+    else if (m_complete)
+    {
+        store(key, nullptr);
+    }
+}
+
+void CachedTable::del(const string &key, const string &op, const string &prefix)
+{
+    Table::del(key, op, prefix);
+    erase(key);
+}
+
+void CachedTable::setMaxStaleness(chrono::milliseconds maxStaleness)
+{
+    m_maxStaleness = maxStaleness;
+}
+
+void CachedTable::refresh()
+{
+    if (m_maxStaleness.count())
+    {
+        auto now = chrono::steady_clock::now();
+        if (now - m_lastRefresh < m_maxStaleness)
+        {
+            return;
+        }
+        m_lastRefresh = now;
+    }
+
+    redisContext *ctx = m_subscribe->getContext();
+    redisReply *reply = nullptr;
+
+    /* Events already read from the socket by a previous readData() */
+    while (redisGetReplyFromReader(ctx, reinterpret_cast<void**>(&reply)) == REDIS_OK && reply != nullptr)
+    {
+        processEvent(reply);
+        freeReplyObject(reply);
+        reply = nullptr;
+    }
+
+    struct pollfd pfd;
+    pfd.fd = ctx->fd;
+    pfd.events = POLLIN;
+
+    while (poll(&pfd, 1, 0) > 0)
+    {
+        readData();
+    }
+}
+
+void CachedTable::readData()
+{
+    redisReply *reply = nullptr;
+
+    if (redisGetReply(m_subscribe->getContext(), reinterpret_cast<void**>(&reply)) != REDIS_OK)
+    {
+        throw runtime_error("Unable to read redis reply");
+    }
+
+    processEvent(reply);
+    freeReplyObject(reply);
+
+    reply = nullptr;
+    int status;
+    do
+    {
+        status = redisGetReplyFromReader(m_subscribe->getContext(), reinterpret_cast<void**>(&reply));
+        if (reply != nullptr && status == REDIS_OK)
+        {
+            processEvent(reply);
+            freeReplyObject(reply);
+        }
+    }
+    while (reply != nullptr && status == REDIS_OK);
+
+    if (status != REDIS_OK)
+    {
+        throw runtime_error("Unable to read redis reply");
+    }
+}
+
+void CachedTable::processEvent(redisReply *reply)
+{
+    /* Expecting pmessage, pattern, channel and event */
+    if (reply->type != REDIS_REPLY_ARRAY || reply->elements != 4)
+    {
+        return;
+    }
+
+    if (m_keyspace != reply->element[1]->str)
+    {
+        SWSS_LOG_ERROR("invalid pattern %s returned for pmessage of %s",
+                       reply->element[1]->str, m_keyspace.c_str());
+        return;
+    }
+
+    /* Channel is the pattern without the trailing '*' followed by the key */
+    string channel = reply->element[2]->str;
+    string key = channel.substr(m_keyspace.length() - 1);
+    const char *event = reply->element[3]->str;
+
+    if (strcmp(event, "del") == 0 ||
+        strcmp(event, "expired") == 0 ||
+        strcmp(event, "evicted") == 0)
+    {
+        erase(key);
+        return;
+    }
+
+    auto it = m_cache.find(key);
+    if (it != m_cache.end())
+    {
+        it->second.valid = false;
+    }
+    else if (m_complete)
+    {
+        /* New key, fetched on first get() */
+        store(key, nullptr);
+    }
+}
+
+void CachedTable::store(const string &key, const vector<FieldValueTuple> *values)
+{
+    auto it = m_cache.find(key);
+    if (it == m_cache.end())
+    {
+        if (m_maxEntries && m_cache.size() >= m_maxEntries)
+        {
+            m_cache.erase(m_lru.back());
+            m_lru.pop_back();
+            m_complete = false;
+        }
+
+        m_lru.push_front(key);
+
+        Entry entry;
+        entry.valid = false;
+        entry.lru = m_lru.begin();
+        it = m_cache.emplace(key, entry).first;
+    }
+    else
+    {
+        touch(it);
+    }
+
+    if (values)
+    {
+        it->second.values = *values;
+        it->second.valid = true;
+    }
+    else
+    {
+        it->second.values.clear();
+        it->second.valid = false;
+    }
+}
+
+void CachedTable::erase(const string &key)
+{
+    auto it = m_cache.find(key);
+    if (it == m_cache.end())
+    {
+        return;
+    }
+
+    m_lru.erase(it->second.lru);
+    m_cache.erase(it);
+}
+
+void CachedTable::touch(Cache::iterator it)
+{
+    m_lru.splice(m_lru.begin(), m_lru, it->second.lru);
+}
+
+size_t CachedTable::size() const
+{
+    return m_cache.size();
+}
+
+uint64_t CachedTable::getHits() const
+{
+    return m_hits;
+}
+
+uint64_t CachedTable::getMisses() const
+{
+    return m_misses;
+}
+
+}
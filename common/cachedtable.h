@@ -0,0 +1,94 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <list>
+#include <chrono>
+#include <unordered_map>
+#include <stdint.h>
+#include "dbconnector.h"
+#include "table.h"
+#include "redisselect.h"
+
+namespace swss {
+
+/*
+ * Table which serves get() and getKeys() from a local copy
+ *
+ * The copy is loaded once with SCAN and kept current through keyspace
+ * notifications (notify-keyspace-events must include "K" and generic and
+ * hash events), which invalidate the changed keys, refetched on the next
+ * get(). Pending notifications are applied on every get(), or at most
+ * every max staleness interval. The table can also be added to a Select
+ * to apply them in the background.
+ *
+ * With a max number of entries the least recently used ones are evicted,
+ * the copy is then partial and misses go to Redis.
+ */
+class CachedTable : public Table, public RedisSelect
+{
+public:
+    CachedTable(DBConnector *db, const std::string &tableName, size_t maxEntries = 0);
+
+    bool get(const std::string &key, std::vector<FieldValueTuple> &values) override;
+
+    void getKeys(std::vector<std::string> &keys) override;
+
+    /* Entries are written to Redis directly and invalidated locally */
+    void set(const std::string &key,
+             const std::vector<FieldValueTuple> &values,
+             const std::string &op = "",
+             const std::string &prefix = EMPTY_PREFIX) override;
+
+    void del(const std::string &key,
+             const std::string &op = "",
+             const std::string &prefix = EMPTY_PREFIX) override;
+
+    /* Don't look for notifications more often than maxStaleness */
+    void setMaxStaleness(std::chrono::milliseconds maxStaleness);
+
+    /* Apply pending keyspace notifications */
+    void refresh();
+
+    /* Read keyspace events from redis */
+    void readData() override;
+
+    size_t size() const;
+    uint64_t getHits() const;
+    uint64_t getMisses() const;
+
+private:
+    struct Entry
+    {
+        bool valid;
+        std::vector<FieldValueTuple> values;
+        std::list<std::string>::iterator lru;
+    };
+
+    typedef std::unordered_map<std::string, Entry> Cache;
+
+    void load();
+    void processEvent(redisReply *reply);
+
+    void store(const std::string &key, const std::vector<FieldValueTuple> *values);
+    void erase(const std::string &key);
+    void touch(Cache::iterator it);
+
+    DBConnector *m_db;
+    std::string m_keyspace;
+    size_t m_maxEntries;
+
+    /* Every key of the table is in the cache, a miss means no such key */
+    bool m_complete;
+
+    Cache m_cache;
+    std::list<std::string> m_lru;
+
+    std::chrono::milliseconds m_maxStaleness;
+    std::chrono::time_point<std::chrono::steady_clock> m_lastRefresh;
+
+    uint64_t m_hits;
+    uint64_t m_misses;
+};
+
+}
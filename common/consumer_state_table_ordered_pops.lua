@@ -0,0 +1,21 @@
+local ret = {}
+local keys = redis.call('ZRANGE', KEYS[1], 0, ARGV[1] - 1)
+local n = table.getn(keys)
+if n > 0 then
+   redis.call('ZREMRANGEBYRANK', KEYS[1], 0, n - 1)
+end
+local traced = redis.call('EXISTS', KEYS[3]) == 1
+for i = 1, n do
+   local key = keys[i]
+   local values = redis.call('HGETALL', KEYS[2] .. key)
+   local entry = {key, values}
+   if traced then
+      local trace = redis.call('HGET', KEYS[3], key)
+      if trace then
+         redis.call('HDEL', KEYS[3], key)
+         table.insert(entry, trace)
+      end
+   end
+   table.insert(ret, entry)
+end
+return ret
@@ -1,9 +1,18 @@
 local ret = {}
 local keys = redis.call('SPOP', KEYS[1], ARGV[1])
 local n = table.getn(keys)
+local traced = redis.call('EXISTS', KEYS[3]) == 1
 for i = 1, n do
    local key = keys[i]
    local values = redis.call('HGETALL', KEYS[2] .. key)
-   table.insert(ret, {key, values})
+   local entry = {key, values}
+   if traced then
+      local trace = redis.call('HGET', KEYS[3], key)
+      if trace then
+         redis.call('HDEL', KEYS[3], key)
+         table.insert(entry, trace)
+      end
+   end
+   table.insert(ret, entry)
 end
 return ret
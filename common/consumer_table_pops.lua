@@ -16,6 +16,12 @@ for i = n, 1, -1 do
    op = op:sub(2)
    local ret = {key, op}
 
+-- a trace carried after the op is returned with it, never written to the table
+   local sep = string.find(op, '|', 1, true)
+   if sep then
+       op = op:sub(1, sep - 1)
+   end
+
    local jj = cjson.decode(value)
    local size = #jj
 
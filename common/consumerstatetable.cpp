@@ -14,6 +14,18 @@ namespace swss {
 ConsumerStateTable::ConsumerStateTable(DBConnector *db, const std::string &tableName, int popBatchSize, int pri)
     : ConsumerTableBase(db, tableName, popBatchSize, pri)
     , TableName_KeySet(tableName)
+{
+    init();
+}
+
+ConsumerStateTable::ConsumerStateTable(DBConnector *db, const std::string &tableName, int shard, int popBatchSize, int pri)
+    : ConsumerTableBase(db, tableName, popBatchSize, pri)
+    , TableName_KeySet(tableName, shard)
+{
+    init();
+}
+
+void ConsumerStateTable::init()
 {
     for (;;)
     {
@@ -21,7 +33,7 @@ ConsumerStateTable::ConsumerStateTable(DBConnector *db, const std::string &table
         watch.checkStatusOK();
         multi();
         enqueue(std::string("SCARD ") + getKeySetName(), REDIS_REPLY_INTEGER);
-        subscribe(m_db, getChannelName());
+        subscribe(m_db, getKeySetChannelName());
         bool succ = exec();
         if (succ) break;
     }
@@ -38,10 +50,11 @@ void ConsumerStateTable::pops(std::deque<KeyOpFieldsValuesTuple> &vkco, const st
 
     RedisCommand command;
     command.format(
-        "EVALSHA %s 2 %s %s: %d ''",
+        "EVALSHA %s 3 %s %s: %s %d ''",
         sha.c_str(),
         getKeySetName().c_str(),
         getTableName().c_str(),
+        getKeySetTraceName().c_str(),
         POP_BATCH_SIZE);
 
     RedisReply r(m_db, command);
@@ -51,6 +64,7 @@ void ConsumerStateTable::pops(std::deque<KeyOpFieldsValuesTuple> &vkco, const st
     // if the set is empty, return an empty kco object
     if (ctx0->type == REDIS_REPLY_NIL)
     {
+        countPops(0);
         return;
     }
 
@@ -64,7 +78,7 @@ void ConsumerStateTable::pops(std::deque<KeyOpFieldsValuesTuple> &vkco, const st
         assert(values.empty());
 
         auto& ctx = ctx0->element[ie];
-        assert(ctx->elements == 2);
+        assert(ctx->elements == 2 || ctx->elements == 3);
         assert(ctx->element[0]->type == REDIS_REPLY_STRING);
         std::string key = ctx->element[0]->str;
         kfvKey(kco) = key;
@@ -79,6 +93,11 @@ void ConsumerStateTable::pops(std::deque<KeyOpFieldsValuesTuple> &vkco, const st
             values.push_back(e);
         }
 
+        if (ctx->elements == 3)
+        {
+            trace(ctx->element[2]->str);
+        }
+
         // if there is no field-value pair, the key is already deleted
         if (values.empty())
         {
@@ -89,6 +108,8 @@ void ConsumerStateTable::pops(std::deque<KeyOpFieldsValuesTuple> &vkco, const st
             kfvOp(kco) = SET_COMMAND;
         }
     }
+
+    countPops(n);
 }
 
 }
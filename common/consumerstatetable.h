@@ -14,6 +14,14 @@ public:
 
     /* Get multiple pop elements */
     void pops(std::deque<KeyOpFieldsValuesTuple> &vkco, const std::string &prefix = EMPTY_PREFIX);
+
+protected:
+    /* Drain a single shard of a sharded table */
+    ConsumerStateTable(DBConnector *db, const std::string &tableName, int shard, int popBatchSize, int pri);
+
+private:
+    /* Subscribe and get the initial queue length */
+    void init();
 };
 
 }
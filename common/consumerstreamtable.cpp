@@ -0,0 +1,219 @@
+#include <string.h>
+#include <string>
+#include <deque>
+#include <vector>
+#include <algorithm>
+#include <system_error>
+#include <hiredis/hiredis.h>
+#include "dbconnector.h"
+#include "table.h"
+#include "selectable.h"
+#include "redisselect.h"
+#include "redisapi.h"
+#include "consumerstreamtable.h"
+
+using namespace std;
+
+namespace swss {
+
+constexpr const char *ConsumerStreamTable::DEFAULT_CONSUMER_NAME;
+
+ConsumerStreamTable::ConsumerStreamTable(DBConnector *db, const string &tableName, int popBatchSize, int pri,
+                                         const string &consumerName)
+    : ConsumerTableBase(db, tableName, popBatchSize, pri)
+    , TableName_Stream(tableName)
+    , m_consumerName(consumerName)
+{
+    string luaAck =
+        "redis.call('XACK', KEYS[1], ARGV[1], unpack(ARGV, 2))\n"
+        "redis.call('XDEL', KEYS[1], unpack(ARGV, 2))\n";
+    m_shaAck = loadRedisScript(m_db, luaAck);
+
+    createGroup();
+
+    /* Entries delivered to this consumer before a restart but never acknowledged */
+    readPending();
+
+    m_subscribe.reset(m_db->newConnector(SUBSCRIBE_TIMEOUT));
+    requestEntries();
+}
+
+void ConsumerStreamTable::createGroup()
+{
+    RedisCommand command;
+    command.format("XGROUP CREATE %s %s 0 MKSTREAM",
+                   getStreamName().c_str(),
+                   getStreamGroupName().c_str());
+
+    try
+    {
+        RedisReply r(m_db, command, REDIS_REPLY_STATUS);
+        r.checkStatusOK();
+    }
+    catch (const system_error &e)
+    {
+        /* The group already exists, created by an earlier run or another consumer */
+        if (strstr(e.what(), "BUSYGROUP") == NULL)
+        {
+            throw;
+        }
+    }
+}
+
+void ConsumerStreamTable::readPending()
+{
+    RedisCommand command;
+    command.format("XREADGROUP GROUP %s %s STREAMS %s 0",
+                   getStreamGroupName().c_str(),
+                   m_consumerName.c_str(),
+                   getStreamName().c_str());
+
+    RedisReply r(m_db, command);
+    parseEntries(r.getContext());
+}
+
+void ConsumerStreamTable::requestEntries()
+{
+    string group = getStreamGroupName();
+    string stream = getStreamName();
+    string count = to_string(POP_BATCH_SIZE);
+    const char *args[] = {
+        "XREADGROUP", "GROUP", group.c_str(), m_consumerName.c_str(),
+        "COUNT", count.c_str(), "BLOCK", "0",
+        "STREAMS", stream.c_str(), ">"
+    };
+
+    RedisCommand command;
+    command.formatArgv((int)(sizeof(args) / sizeof(args[0])), args, NULL);
+
+    redisContext *ctx = m_subscribe->getContext();
+    redisAppendFormattedCommand(ctx, command.c_str(), command.length());
+
+    int done = 0;
+    do
+    {
+        if (redisBufferWrite(ctx, &done) != REDIS_OK)
+        {
+            throw runtime_error("Unable to send XREADGROUP");
+        }
+    }
+    while (!done);
+}
+
+void ConsumerStreamTable::parseEntries(redisReply *reply)
+{
+    /* Reply is [[stream, [[id, [key, op, field, value, ...]], ...]]] */
+    if (reply->type != REDIS_REPLY_ARRAY || reply->elements == 0)
+    {
+        return;
+    }
+
+    redisReply *stream = reply->element[0];
+    if (stream->type != REDIS_REPLY_ARRAY || stream->elements != 2)
+    {
+        SWSS_LOG_ERROR("invalid XREADGROUP reply on %s", getStreamName().c_str());
+        throw runtime_error("invalid XREADGROUP reply");
+    }
+
+    redisReply *entries = stream->element[1];
+    for (size_t ie = 0; ie < entries->elements; ie++)
+    {
+        redisReply *entry = entries->element[ie];
+        redisReply *fields = entry->element[1];
+
+        /* Pending entry already deleted from the stream, only acknowledge it */
+        if (fields->type != REDIS_REPLY_ARRAY || fields->elements < 2)
+        {
+            m_unacked.push_back(entry->element[0]->str);
+            continue;
+        }
+
+        KeyOpFieldsValuesTuple kco;
+        kfvKey(kco) = fields->element[0]->str;
+        kfvOp(kco) = fields->element[1]->str;
+
+        auto& values = kfvFieldsValues(kco);
+        for (size_t i = 2; i + 1 < fields->elements; i += 2)
+        {
+            values.emplace_back(fields->element[i]->str, fields->element[i + 1]->str);
+        }
+
+        m_entries.push_back(kco);
+        m_entryIds.push_back(entry->element[0]->str);
+    }
+}
+
+void ConsumerStreamTable::readData()
+{
+    redisReply *reply = nullptr;
+
+    if (redisGetReply(m_subscribe->getContext(), reinterpret_cast<void**>(&reply)) != REDIS_OK)
+        throw std::runtime_error("Unable to read redis reply");
+
+    RedisReply r(reply);
+    if (reply->type == REDIS_REPLY_ERROR)
+    {
+        SWSS_LOG_ERROR("XREADGROUP on %s failed: %s", getStreamName().c_str(), reply->str);
+        throw std::runtime_error("Unable to read redis reply");
+    }
+
+    parseEntries(reply);
+
+    requestEntries();
+}
+
+bool ConsumerStreamTable::hasCachedData()
+{
+    return m_entries.size() + m_buffer.size() > 1;
+}
+
+bool ConsumerStreamTable::initializedWithData()
+{
+    return !m_entries.empty();
+}
+
+void ConsumerStreamTable::updateAfterRead()
+{
+}
+
+void ConsumerStreamTable::ack()
+{
+    /* Lua unpack() is limited by the stack size, acknowledge in chunks */
+    static const size_t ACK_CHUNK_SIZE = 1024;
+
+    string stream = getStreamName();
+    string group = getStreamGroupName();
+
+    for (size_t start = 0; start < m_unacked.size(); start += ACK_CHUNK_SIZE)
+    {
+        size_t end = min(start + ACK_CHUNK_SIZE, m_unacked.size());
+
+        vector<const char *> args = {
+            "EVALSHA", m_shaAck.c_str(), "1", stream.c_str(), group.c_str()
+        };
+        transform(m_unacked.begin() + start, m_unacked.begin() + end, back_inserter(args),
+                  [](const string &s) { return s.c_str(); } );
+
+        RedisCommand command;
+        command.formatArgv((int)args.size(), args.data(), NULL);
+        RedisReply r(m_db, command, REDIS_REPLY_NIL);
+    }
+
+    m_unacked.clear();
+}
+
+void ConsumerStreamTable::pops(deque<KeyOpFieldsValuesTuple> &vkco, const string& /*prefix*/)
+{
+    /* The caller is done with what the previous pops() returned */
+    ack();
+
+    vkco.clear();
+    vkco.swap(m_entries);
+
+    m_unacked.insert(m_unacked.end(), m_entryIds.begin(), m_entryIds.end());
+    m_entryIds.clear();
+
+    countPops(vkco.size());
+}
+
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <string>
+#include <deque>
+#include <vector>
+#include "dbconnector.h"
+#include "consumertablebase.h"
+
+namespace swss {
+
+/*
+ * Reads the stream written by ProducerStreamTable through a consumer group
+ *
+ * The selectable fd is the connection blocked in XREADGROUP, no separate
+ * pub/sub connection is used. Entries returned by pops() are acknowledged
+ * and removed from the stream on the next pops() or on ack(), so entries
+ * not yet processed are delivered again to a consumer restarted with the
+ * same name.
+ */
+class ConsumerStreamTable : public ConsumerTableBase, public TableName_Stream
+{
+public:
+    static constexpr const char *DEFAULT_CONSUMER_NAME = "consumer";
+
+    ConsumerStreamTable(DBConnector *db, const std::string &tableName, int popBatchSize = DEFAULT_POP_BATCH_SIZE, int pri = 0,
+                        const std::string &consumerName = DEFAULT_CONSUMER_NAME);
+
+    /* Get multiple pop elements */
+    void pops(std::deque<KeyOpFieldsValuesTuple> &vkco, const std::string &prefix = EMPTY_PREFIX);
+
+    /* Acknowledge entries returned by the last pops() */
+    void ack();
+
+    void readData() override;
+    bool hasCachedData() override;
+    bool initializedWithData() override;
+    void updateAfterRead() override;
+
+private:
+    void createGroup();
+    void readPending();
+
+    /* Send a blocking XREADGROUP on the selectable connection */
+    void requestEntries();
+
+    void parseEntries(redisReply *reply);
+
+    std::string m_consumerName;
+    std::string m_shaAck;
+
+    std::deque<KeyOpFieldsValuesTuple> m_entries;
+    std::deque<std::string> m_entryIds;
+    std::vector<std::string> m_unacked;
+};
+
+}
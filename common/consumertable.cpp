@@ -9,6 +9,7 @@
 #include "common/json.h"
 #include "common/logger.h"
 #include "common/redisapi.h"
+#include "common/tracing.h"
 
 using namespace std;
 
@@ -74,6 +75,14 @@ void ConsumerTable::pops(deque<KeyOpFieldsValuesTuple> &vkco, const string &pref
         string key = ctx->element[0]->str;
         kfvKey(kco) = key;
         string op  = ctx->element[1]->str;
+
+        // a trace is carried after the op, see Tracing
+        size_t sep = op.find(Tracing::OP_SEPARATOR);
+        if (sep != string::npos)
+        {
+            trace(op.substr(sep + 1));
+            op.erase(sep);
+        }
         kfvOp(kco) = op;
 
         for (size_t i = 2; i < ctx->elements; i += 2)
@@ -91,6 +100,8 @@ void ConsumerTable::pops(deque<KeyOpFieldsValuesTuple> &vkco, const string &pref
             values.push_back(e);
         }
     }
+
+    countPops(n);
 }
 
 }
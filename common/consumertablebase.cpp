@@ -1,3 +1,5 @@
+#include "logger.h"
+#include "tracing.h"
 #include "consumertablebase.h"
 
 namespace swss {
@@ -5,7 +7,11 @@ namespace swss {
 ConsumerTableBase::ConsumerTableBase(DBConnector *db, const std::string &tableName, int popBatchSize, int pri):
         TableConsumable(db->getDbId(), tableName, pri),
         RedisTransactioner(db),
-        POP_BATCH_SIZE(popBatchSize)
+        POP_BATCH_SIZE(popBatchSize),
+        m_latency(MetricsRegistry::getInstance().getHistogram("consumer." + tableName + ".latency_us")),
+        m_popsMetric(MetricsRegistry::getInstance().getCounter("consumer." + tableName + ".pops")),
+        m_entriesMetric(MetricsRegistry::getInstance().getCounter("consumer." + tableName + ".entries")),
+        m_batchMetric(MetricsRegistry::getInstance().getHistogram("consumer." + tableName + ".batch_size"))
 {
 }
 
@@ -42,4 +48,31 @@ void ConsumerTableBase::pop(std::string &key, std::string &op, std::vector<Field
     m_buffer.pop_front();
 }
 
+void ConsumerTableBase::countPops(size_t entries)
+{
+    m_popsMetric.inc();
+    m_entriesMetric.inc(entries);
+    m_batchMetric.record(entries);
+}
+
+const Histogram &ConsumerTableBase::getLatencyHistogram() const
+{
+    return m_latency;
+}
+
+void ConsumerTableBase::trace(const std::string &value)
+{
+    uint64_t latency;
+    std::string traceId;
+
+    if (!Tracing::parse(value, latency, traceId))
+    {
+        SWSS_LOG_WARN("%s malformed trace %s", getTableName().c_str(), value.c_str());
+        return;
+    }
+
+    m_latency.record(latency);
+    SWSS_LOG_DEBUG("%s trace %s latency %lu us", getTableName().c_str(), traceId.c_str(), latency);
+}
+
 }
@@ -2,6 +2,8 @@
 
 #include "table.h"
 #include "selectable.h"
+#include "histogram.h"
+#include "metrics.h"
 
 namespace swss {
 
@@ -18,9 +20,24 @@ public:
 
     void pop(std::string &key, std::string &op, std::vector<FieldValueTuple> &fvs, const std::string &prefix = EMPTY_PREFIX);
 
+    /* Produce to consume latency in microseconds of traced entries, shared
+     * by the consumers of the table in the process */
+    const Histogram &getLatencyHistogram() const;
+
 protected:
 
     std::deque<KeyOpFieldsValuesTuple> m_buffer;
+
+    Histogram &m_latency;
+    Counter &m_popsMetric;
+    Counter &m_entriesMetric;
+    Histogram &m_batchMetric;
+
+    /* Account for a pops() call returning entries */
+    void countPops(size_t entries);
+
+    /* Record the latency of the trace popped with an entry */
+    void trace(const std::string &value);
 };
 
 }
@@ -0,0 +1,320 @@
+#pragma once
+
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include <stdint.h>
+#include "hash.h"
+
+namespace swss {
+
+/*
+ * Open addressing hash map for small fixed-size keys such as IpAddress,
+ * IpPrefix and MacAddress
+ *
+ * Entries are stored inline in one array probed linearly, next to a byte
+ * per slot holding 7 bits of the key hash, so most probes never touch a
+ * key that does not match. Erase shifts the following entries back
+ * instead of leaving tombstones, so lookups stay short under churn.
+ *
+ * K and V must be default constructible. Inserting or erasing invalidates
+ * iterators and pointers to values.
+ */
+template <typename K, typename V, typename Hash = std::hash<K>, typename Eq = std::equal_to<K>>
+class FlatHashMap
+{
+public:
+    typedef std::pair<K, V> value_type;
+
+    template <typename Map, typename Value>
+    class Iterator : public std::iterator<std::forward_iterator_tag, Value>
+    {
+    public:
+        Iterator(Map *map, size_t index) : m_map(map), m_index(index)
+        {
+            skip();
+        }
+
+        Value &operator*() const { return m_map->m_slots[m_index]; }
+        Value *operator->() const { return &m_map->m_slots[m_index]; }
+
+        Iterator &operator++()
+        {
+            m_index++;
+            skip();
+            return *this;
+        }
+
+        bool operator==(const Iterator &o) const { return m_index == o.m_index; }
+        bool operator!=(const Iterator &o) const { return m_index != o.m_index; }
+
+    private:
+        void skip()
+        {
+            while (m_index < m_map->m_tags.size() && !m_map->m_tags[m_index])
+            {
+                m_index++;
+            }
+        }
+
+        Map *m_map;
+        size_t m_index;
+    };
+
+    typedef Iterator<FlatHashMap, value_type> iterator;
+    typedef Iterator<const FlatHashMap, const value_type> const_iterator;
+
+    FlatHashMap() : m_size(0) {}
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, m_tags.size()); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, m_tags.size()); }
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    V *find(const K &key)
+    {
+        if (m_size == 0)
+        {
+            return nullptr;
+        }
+
+        uint64_t h = hashOf(key);
+        uint8_t tag = tagOf(h);
+
+        for (size_t i = static_cast<size_t>(h) & mask(); m_tags[i]; i = (i + 1) & mask())
+        {
+            if (m_tags[i] == tag && m_eq(m_slots[i].first, key))
+            {
+                return &m_slots[i].second;
+            }
+        }
+
+        return nullptr;
+    }
+
+    const V *find(const K &key) const
+    {
+        return const_cast<FlatHashMap *>(this)->find(key);
+    }
+
+    bool contains(const K &key) const
+    {
+        return find(key) != nullptr;
+    }
+
+    /* Returns false and leaves the map unchanged when key is present */
+    bool insert(const K &key, const V &value)
+    {
+        bool added;
+        V &v = slot(key, added);
+
+        if (added)
+        {
+            v = value;
+        }
+
+        return added;
+    }
+
+    V &operator[](const K &key)
+    {
+        bool added;
+        return slot(key, added);
+    }
+
+    bool erase(const K &key)
+    {
+        if (m_size == 0)
+        {
+            return false;
+        }
+
+        uint64_t h = hashOf(key);
+        uint8_t tag = tagOf(h);
+        size_t i = static_cast<size_t>(h) & mask();
+
+        while (m_tags[i] && !(m_tags[i] == tag && m_eq(m_slots[i].first, key)))
+        {
+            i = (i + 1) & mask();
+        }
+
+        if (!m_tags[i])
+        {
+            return false;
+        }
+
+        /* Move back the following entries that probed past the hole */
+        for (size_t j = (i + 1) & mask(); m_tags[j]; j = (j + 1) & mask())
+        {
+            size_t home = static_cast<size_t>(hashOf(m_slots[j].first)) & mask();
+
+            if (((j - home) & mask()) >= ((j - i) & mask()))
+            {
+                m_slots[i] = std::move(m_slots[j]);
+                m_tags[i] = m_tags[j];
+                i = j;
+            }
+        }
+
+        /* The key is left as is, the tag alone marks the slot free */
+        m_slots[i].second = V();
+        m_tags[i] = 0;
+        m_size--;
+        return true;
+    }
+
+    void clear()
+    {
+        m_slots.clear();
+        m_tags.clear();
+        m_size = 0;
+    }
+
+    /* Make room for count entries without rehashing */
+    void reserve(size_t count)
+    {
+        size_t capacity = MIN_CAPACITY;
+
+        while (capacity * MAX_LOAD_NUM < count * MAX_LOAD_DEN)
+        {
+            capacity *= 2;
+        }
+
+        if (capacity > m_tags.size())
+        {
+            rehash(capacity);
+        }
+    }
+
+private:
+    static const size_t MIN_CAPACITY = 16;
+    static const size_t MAX_LOAD_NUM = 7;
+    static const size_t MAX_LOAD_DEN = 8;
+
+    size_t mask() const
+    {
+        return m_tags.size() - 1;
+    }
+
+    /* Mixed again so that weak hashes, e.g. of integers, spread too */
+    uint64_t hashOf(const K &key) const
+    {
+        return hashMix(static_cast<uint64_t>(m_hash(key)));
+    }
+
+    /* Top 7 bits of the hash, the low ones select the slot. 0 marks a free slot */
+    static uint8_t tagOf(uint64_t h)
+    {
+        return static_cast<uint8_t>(0x80 | (h >> 57));
+    }
+
+    V &slot(const K &key, bool &added)
+    {
+        if ((m_size + 1) * MAX_LOAD_DEN > m_tags.size() * MAX_LOAD_NUM)
+        {
+            reserve(m_size + 1);
+        }
+
+        uint64_t h = hashOf(key);
+        uint8_t tag = tagOf(h);
+        size_t i = static_cast<size_t>(h) & mask();
+
+        for (; m_tags[i]; i = (i + 1) & mask())
+        {
+            if (m_tags[i] == tag && m_eq(m_slots[i].first, key))
+            {
+                added = false;
+                return m_slots[i].second;
+            }
+        }
+
+        m_tags[i] = tag;
+        m_slots[i].first = key;
+        m_size++;
+        added = true;
+        return m_slots[i].second;
+    }
+
+    void rehash(size_t capacity)
+    {
+        std::vector<value_type> slots(capacity);
+        std::vector<uint8_t> tags(capacity, 0);
+
+        slots.swap(m_slots);
+        tags.swap(m_tags);
+
+        for (size_t j = 0; j < tags.size(); j++)
+        {
+            if (!tags[j])
+            {
+                continue;
+            }
+
+            size_t i = static_cast<size_t>(hashOf(slots[j].first)) & mask();
+            while (m_tags[i])
+            {
+                i = (i + 1) & mask();
+            }
+
+            m_slots[i] = std::move(slots[j]);
+            m_tags[i] = tags[j];
+        }
+    }
+
+    std::vector<value_type> m_slots;
+    std::vector<uint8_t> m_tags;
+    size_t m_size;
+    Hash m_hash;
+    Eq m_eq;
+};
+
+/* Set counterpart of FlatHashMap */
+template <typename K, typename Hash = std::hash<K>, typename Eq = std::equal_to<K>>
+class FlatHashSet
+{
+    struct Empty {};
+    typedef FlatHashMap<K, Empty, Hash, Eq> Map;
+
+public:
+    class const_iterator : public std::iterator<std::forward_iterator_tag, const K>
+    {
+    public:
+        const_iterator(typename Map::const_iterator it) : m_it(it) {}
+
+        const K &operator*() const { return m_it->first; }
+        const K *operator->() const { return &m_it->first; }
+
+        const_iterator &operator++()
+        {
+            ++m_it;
+            return *this;
+        }
+
+        bool operator==(const const_iterator &o) const { return m_it == o.m_it; }
+        bool operator!=(const const_iterator &o) const { return m_it != o.m_it; }
+
+    private:
+        typename Map::const_iterator m_it;
+    };
+
+    const_iterator begin() const { return const_iterator(m_map.begin()); }
+    const_iterator end() const { return const_iterator(m_map.end()); }
+
+    size_t size() const { return m_map.size(); }
+    bool empty() const { return m_map.empty(); }
+
+    bool insert(const K &key) { return m_map.insert(key, Empty()); }
+    bool erase(const K &key) { return m_map.erase(key); }
+    bool contains(const K &key) const { return m_map.contains(key); }
+    void clear() { m_map.clear(); }
+    void reserve(size_t count) { m_map.reserve(count); }
+
+private:
+    Map m_map;
+};
+
+}
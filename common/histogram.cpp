@@ -0,0 +1,114 @@
+#include <stdint.h>
+#include "histogram.h"
+
+namespace swss {
+
+constexpr int Histogram::SUB_BUCKET_BITS;
+constexpr int Histogram::SUB_BUCKETS;
+constexpr int Histogram::LINEAR_BUCKETS;
+constexpr int Histogram::BUCKETS;
+
+Histogram::Histogram()
+{
+    reset();
+}
+
+int Histogram::getBucket(uint64_t value)
+{
+    if (value < LINEAR_BUCKETS)
+    {
+        return static_cast<int>(value);
+    }
+
+    /* Index of the highest bit set, at least SUB_BUCKET_BITS + 1 */
+    int exponent = 63 - __builtin_clzll(value);
+    int shift = exponent - SUB_BUCKET_BITS;
+    int sub = static_cast<int>((value >> shift) & (SUB_BUCKETS - 1));
+
+    return LINEAR_BUCKETS + (exponent - SUB_BUCKET_BITS - 1) * SUB_BUCKETS + sub;
+}
+
+uint64_t Histogram::getBucketUpperBound(int bucket)
+{
+    if (bucket < LINEAR_BUCKETS)
+    {
+        return static_cast<uint64_t>(bucket);
+    }
+
+    int exponent = (bucket - LINEAR_BUCKETS) / SUB_BUCKETS + SUB_BUCKET_BITS + 1;
+    int shift = exponent - SUB_BUCKET_BITS;
+    uint64_t sub = static_cast<uint64_t>((bucket - LINEAR_BUCKETS) % SUB_BUCKETS);
+    uint64_t lower = (SUB_BUCKETS + sub) << shift;
+
+    return lower + ((1ULL << shift) - 1);
+}
+
+void Histogram::record(uint64_t value)
+{
+    m_buckets[getBucket(value)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t max = m_max.load(std::memory_order_relaxed);
+    while (value > max && !m_max.compare_exchange_weak(max, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+uint64_t Histogram::getCount() const
+{
+    return m_count.load(std::memory_order_relaxed);
+}
+
+uint64_t Histogram::getSum() const
+{
+    return m_sum.load(std::memory_order_relaxed);
+}
+
+uint64_t Histogram::getMax() const
+{
+    return m_max.load(std::memory_order_relaxed);
+}
+
+uint64_t Histogram::getPercentile(double percentile) const
+{
+    uint64_t count = getCount();
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    /* Rank of the value, 1 based */
+    uint64_t rank = static_cast<uint64_t>(percentile / 100.0 * static_cast<double>(count) + 0.5);
+    if (rank < 1)
+    {
+        rank = 1;
+    }
+
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKETS; i++)
+    {
+        seen += m_buckets[i].load(std::memory_order_relaxed);
+        if (seen >= rank)
+        {
+            uint64_t bound = getBucketUpperBound(i);
+            uint64_t max = getMax();
+            return bound < max ? bound : max;
+        }
+    }
+
+    return getMax();
+}
+
+void Histogram::reset()
+{
+    for (int i = 0; i < BUCKETS; i++)
+    {
+        m_buckets[i].store(0, std::memory_order_relaxed);
+    }
+    m_count.store(0, std::memory_order_relaxed);
+    m_sum.store(0, std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+}
+
+}
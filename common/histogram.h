@@ -0,0 +1,49 @@
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+namespace swss {
+
+/*
+ * Lock-free log-linear histogram of unsigned values
+ *
+ * Values below 16 are counted exactly, above that each power of two is
+ * split in 8 buckets, so the value returned by getPercentile() is within
+ * 12.5% of the recorded one.
+ */
+class Histogram
+{
+public:
+    static constexpr int SUB_BUCKET_BITS = 3;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static constexpr int LINEAR_BUCKETS = 2 * SUB_BUCKETS;
+    static constexpr int BUCKETS = LINEAR_BUCKETS + (64 - SUB_BUCKET_BITS - 1) * SUB_BUCKETS;
+
+    Histogram();
+
+    Histogram(const Histogram&) = delete;
+    Histogram &operator=(const Histogram&) = delete;
+
+    void record(uint64_t value);
+
+    uint64_t getCount() const;
+    uint64_t getSum() const;
+    uint64_t getMax() const;
+
+    /* Upper bound of the bucket holding the given percentile (0 to 100) */
+    uint64_t getPercentile(double percentile) const;
+
+    void reset();
+
+    static int getBucket(uint64_t value);
+    static uint64_t getBucketUpperBound(int bucket);
+
+private:
+    std::atomic<uint64_t> m_buckets[BUCKETS];
+    std::atomic<uint64_t> m_count;
+    std::atomic<uint64_t> m_sum;
+    std::atomic<uint64_t> m_max;
+};
+
+}
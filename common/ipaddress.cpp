@@ -5,37 +5,332 @@
 
 using namespace swss;
 
-IpAddress::IpAddress(uint32_t ip)
+const size_t IpAddress::MAX_STRING_LEN;
+
+IpAddress::IpAddress(const std::string &ipStr)
 {
-    m_ip.family = AF_INET;
-    m_ip.ip_addr.ipv4_addr = ip;
+    if (!parse(ipStr.data(), ipStr.size(), *this))
+    {
+        std::string err = "Error converting " + ipStr + " to IP address";
+        throw std::invalid_argument(err);
+    }
 }
 
-IpAddress::IpAddress(const std::string &ipStr)
+std::string IpAddress::to_string() const
 {
-    if (ipStr.find(':') != std::string::npos)
+    char buf[MAX_STRING_LEN];
+
+    return std::string(buf, format(buf));
+}
+
+/* Dotted quad without leading zeros, as inet_pton() takes it */
+static bool parseV4(const char *p, const char *end, uint8_t *out)
+{
+    int octets = 0;
+
+    while (true)
     {
-        m_ip.family = AF_INET6;
+        const char *start = p;
+        unsigned int value = 0;
+
+        while (p != end && *p >= '0' && *p <= '9')
+        {
+            value = value * 10 + static_cast<unsigned int>(*p - '0');
+            if (value > 255)
+            {
+                return false;
+            }
+            p++;
+        }
+
+        if (p == start || (p - start > 1 && *start == '0'))
+        {
+            return false;
+        }
+
+        out[octets++] = static_cast<uint8_t>(value);
+
+        if (p == end)
+        {
+            return octets == 4;
+        }
+
+        if (*p != '.' || octets == 4)
+        {
+            return false;
+        }
+        p++;
     }
-    else
+}
+
+/* Value of a hex digit, -1 for other characters */
+static const signed char hexValues[256] = {
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+     0,  1,  2,  3,  4,  5,  6,  7,  8,  9, -1, -1, -1, -1, -1, -1,
+    -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+};
+
+static inline int hexValue(char c)
+{
+    return hexValues[static_cast<unsigned char>(c)];
+}
+
+/* Same grammar as glibc inet_pton6(), including a trailing dotted quad */
+static bool parseV6(const char *p, const char *end, uint8_t *out)
+{
+    uint8_t tmp[16] = { 0 };
+    int tp = 0;
+    int colonp = -1;
+
+    if (p != end && *p == ':')
     {
-        m_ip.family = AF_INET;
+        if (++p == end || *p != ':')
+        {
+            return false;
+        }
     }
 
-    if (inet_pton(m_ip.family, ipStr.c_str(), &m_ip.ip_addr) != 1)
+    const char *token = p;
+    bool sawDigit = false;
+    int digits = 0;
+    unsigned int value = 0;
+
+    while (p != end)
     {
-        std::string err = "Error converting " + ipStr + " to IP address";
-        throw std::invalid_argument(err);
+        char c = *p++;
+        int h = hexValue(c);
+
+        if (h >= 0)
+        {
+            if (++digits > 4)
+            {
+                return false;
+            }
+            value = (value << 4) | static_cast<unsigned int>(h);
+            sawDigit = true;
+            continue;
+        }
+
+        if (c == ':')
+        {
+            token = p;
+            if (!sawDigit)
+            {
+                if (colonp >= 0)
+                {
+                    return false;
+                }
+                colonp = tp;
+                continue;
+            }
+
+            if (p == end || tp + 2 > 16)
+            {
+                return false;
+            }
+
+            tmp[tp++] = static_cast<uint8_t>(value >> 8);
+            tmp[tp++] = static_cast<uint8_t>(value);
+            sawDigit = false;
+            digits = 0;
+            value = 0;
+            continue;
+        }
+
+        if (c == '.' && tp + 4 <= 16 && parseV4(token, end, tmp + tp))
+        {
+            tp += 4;
+            sawDigit = false;
+            break;
+        }
+
+        return false;
+    }
+
+    if (sawDigit)
+    {
+        if (tp + 2 > 16)
+        {
+            return false;
+        }
+
+        tmp[tp++] = static_cast<uint8_t>(value >> 8);
+        tmp[tp++] = static_cast<uint8_t>(value);
+    }
+
+    if (colonp >= 0)
+    {
+        if (tp == 16)
+        {
+            return false;
+        }
+
+        /* Move what follows "::" to the end */
+        int n = tp - colonp;
+        memmove(tmp + 16 - n, tmp + colonp, n);
+        memset(tmp + colonp, 0, 16 - n - colonp);
+        tp = 16;
     }
+
+    if (tp != 16)
+    {
+        return false;
+    }
+
+    memcpy(out, tmp, 16);
+    return true;
 }
 
-std::string IpAddress::to_string() const
+bool IpAddress::parse(const char *str, size_t len, IpAddress &ip)
+{
+    const char *end = str + len;
+
+    if (memchr(str, ':', len))
+    {
+        if (!parseV6(str, end, ip.m_ip.ip_addr.ipv6_addr))
+        {
+            return false;
+        }
+
+        ip.m_ip.family = AF_INET6;
+        return true;
+    }
+
+    uint8_t bytes[4];
+    if (!parseV4(str, end, bytes))
+    {
+        return false;
+    }
+
+    ip.m_ip.family = AF_INET;
+    memcpy(&ip.m_ip.ip_addr.ipv4_addr, bytes, 4);
+    return true;
+}
+
+static char *formatV4(const uint8_t *bytes, char *buf)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        if (i)
+        {
+            *buf++ = '.';
+        }
+
+        unsigned int v = bytes[i];
+        if (v >= 100)
+        {
+            *buf++ = static_cast<char>('0' + v / 100);
+        }
+        if (v >= 10)
+        {
+            *buf++ = static_cast<char>('0' + v / 10 % 10);
+        }
+        *buf++ = static_cast<char>('0' + v % 10);
+    }
+
+    return buf;
+}
+
+/* Same output as glibc inet_ntop6() */
+static char *formatV6(const uint8_t *bytes, char *buf)
 {
-    char buf[INET6_ADDRSTRLEN];
+    static const char hex[] = "0123456789abcdef";
+    unsigned int words[8];
+    int bestBase = -1, bestLen = 0;
+    int curBase = -1, curLen = 0;
+
+    for (int i = 0; i < 8; i++)
+    {
+        words[i] = static_cast<unsigned int>(bytes[2 * i] << 8 | bytes[2 * i + 1]);
+
+        if (words[i] == 0)
+        {
+            if (curBase < 0)
+            {
+                curBase = i;
+                curLen = 0;
+            }
+            curLen++;
+            if (curLen > bestLen)
+            {
+                bestBase = curBase;
+                bestLen = curLen;
+            }
+        }
+        else
+        {
+            curBase = -1;
+        }
+    }
+
+    /* A single zero word is not compressed */
+    if (bestLen < 2)
+    {
+        bestBase = -1;
+    }
+
+    for (int i = 0; i < 8; i++)
+    {
+        if (bestBase >= 0 && i >= bestBase && i < bestBase + bestLen)
+        {
+            if (i == bestBase)
+            {
+                *buf++ = ':';
+            }
+            continue;
+        }
+
+        if (i)
+        {
+            *buf++ = ':';
+        }
+
+        /* IPv4-compatible and IPv4-mapped addresses end with a dotted quad */
+        if (i == 6 && bestBase == 0 && (bestLen == 6 || (bestLen == 5 && words[5] == 0xffff)))
+        {
+            return formatV4(bytes + 12, buf);
+        }
+
+        unsigned int w = words[i];
+        for (int shift = 12; shift > 0; shift -= 4)
+        {
+            if (w >> shift)
+            {
+                *buf++ = hex[(w >> shift) & 0xf];
+            }
+        }
+        *buf++ = hex[w & 0xf];
+    }
 
-    std::string ipStr(inet_ntop(m_ip.family, &m_ip.ip_addr, buf, INET6_ADDRSTRLEN));
+    if (bestBase >= 0 && bestBase + bestLen == 8)
+    {
+        *buf++ = ':';
+    }
+
+    return buf;
+}
+
+char *IpAddress::format(char *buf) const
+{
+    if (m_ip.family == AF_INET)
+    {
+        return formatV4(reinterpret_cast<const uint8_t *>(&m_ip.ip_addr.ipv4_addr), buf);
+    }
 
-    return ipStr;
+    return formatV6(m_ip.ip_addr.ipv6_addr, buf);
 }
 
 IpAddress::AddrScope IpAddress::getAddrScope() const
@@ -4,7 +4,9 @@
 #include <stdint.h>
 #include <string.h>
 #include <string>
+#include <functional>
 #include <netinet/in.h>
+#include "hash.h"
 
 namespace swss {
 
@@ -21,9 +23,35 @@ class IpAddress
 public:
     IpAddress() {}
     IpAddress(const ip_addr_t &ip) : m_ip(ip) {}
-    IpAddress(uint32_t ip);
+    constexpr IpAddress(uint32_t ip) : m_ip{ AF_INET, { ip } } {}
     IpAddress(const std::string &ipStr);
 
+    /* IPv4 address a.b.c.d, usable in constant expressions */
+    constexpr IpAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) :
+        m_ip{ AF_INET, { toNetworkOrder(static_cast<uint32_t>(a) << 24 | static_cast<uint32_t>(b) << 16 |
+                                        static_cast<uint32_t>(c) << 8 | d) } }
+    {
+    }
+
+    /* htonl() and its 64 bit counterpart, usable in constant expressions */
+    static constexpr uint32_t toNetworkOrder(uint32_t host)
+    {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        return __builtin_bswap32(host);
+#else
+        return host;
+#endif
+    }
+
+    static constexpr uint64_t toNetworkOrder(uint64_t host)
+    {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        return __builtin_bswap64(host);
+#else
+        return host;
+#endif
+    }
+
     inline bool isV4() const
     {
         return m_ip.family == AF_INET;
@@ -31,10 +59,15 @@ public:
 
     inline bool isZero() const
     {
-        unsigned char zerobuf[16] = { 0 };
-
-        return ((m_ip.family == AF_INET && m_ip.ip_addr.ipv4_addr == 0) ||
-                (m_ip.family == AF_INET6 && memcmp(&m_ip.ip_addr.ipv6_addr, zerobuf, 16) == 0));
+        if (m_ip.family == AF_INET)
+        {
+            return m_ip.ip_addr.ipv4_addr == 0;
+        }
+
+        uint64_t hi, lo;
+        memcpy(&hi, m_ip.ip_addr.ipv6_addr, 8);
+        memcpy(&lo, m_ip.ip_addr.ipv6_addr + 8, 8);
+        return m_ip.family == AF_INET6 && (hi | lo) == 0;
     }
 
     inline ip_addr_t getIp() const
@@ -74,6 +107,35 @@ public:
 
     std::string to_string() const;
 
+    inline size_t hash() const
+    {
+        if (m_ip.family == AF_INET)
+        {
+            return static_cast<size_t>(hashMix(m_ip.ip_addr.ipv4_addr));
+        }
+
+        uint64_t hi, lo;
+        memcpy(&hi, m_ip.ip_addr.ipv6_addr, 8);
+        memcpy(&lo, m_ip.ip_addr.ipv6_addr + 8, 8);
+        return static_cast<size_t>(hashCombine(hashMix(hi), lo));
+    }
+
+    /* Room format() needs, INET6_ADDRSTRLEN without the NUL */
+    static const size_t MAX_STRING_LEN = INET6_ADDRSTRLEN - 1;
+
+    /*
+     * Parse the len characters at str, accepting what inet_pton() does.
+     * Returns false instead of throwing when they are not an address.
+     */
+    static bool parse(const char *str, size_t len, IpAddress &ip);
+
+    /*
+     * Write the address as inet_ntop() does to buf, which must have room
+     * for MAX_STRING_LEN characters, and return the end of the text. No
+     * terminating NUL is written.
+     */
+    char *format(char *buf) const;
+
     enum AddrScope {
         GLOBAL_SCOPE,
         LINK_SCOPE,
@@ -88,4 +150,17 @@ private:
 
 }
 
+namespace std {
+
+template <>
+struct hash<swss::IpAddress>
+{
+    size_t operator()(const swss::IpAddress &ip) const
+    {
+        return ip.hash();
+    }
+};
+
+}
+
 #endif
@@ -2,6 +2,7 @@
 #include "tokenize.h"
 
 #include <sstream>
+#include <stdexcept>
 
 using namespace std;
 using namespace swss;
@@ -10,9 +11,19 @@ using namespace swss;
 
 IpAddresses::IpAddresses(const string &ipsStr)
 {
-    auto ips = tokenize(ipsStr, IP_DELIMITER);
-    for (const auto &ip : ips)
+    Tokenizer tokens(ipsStr, IP_DELIMITER);
+    const char *ipStr;
+    size_t len;
+
+    while (tokens.next(ipStr, len))
+    {
+        IpAddress ip;
+        if (!IpAddress::parse(ipStr, len, ip))
+        {
+            throw invalid_argument("Error converting " + string(ipStr, len) + " to IP address");
+        }
         m_ips.insert(ip);
+    }
 }
 
 void IpAddresses::add(const string &ipStr)
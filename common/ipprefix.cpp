@@ -6,50 +6,30 @@
 
 using namespace swss;
 
+const size_t IpPrefix::MAX_STRING_LEN;
+
 IpPrefix::IpPrefix(
     const std::string &ipPrefixStr)
 {
-    size_t pos = ipPrefixStr.find('/');
-    std::string ipStr = ipPrefixStr.substr(0, pos);
-    if (ipStr.empty())
-    {
-        m_ip = IpAddress(0);
-    }
-    else
+    if (!parse(ipPrefixStr.data(), ipPrefixStr.size(), *this))
     {
-        m_ip = IpAddress(ipStr);
+        throw std::invalid_argument("Invalid IpPrefix from string " + ipPrefixStr);
     }
+}
 
-    if (pos == std::string::npos)
-    {
-        if (m_ip.isV4())
-            m_mask = 32;
-        else
-            m_mask = 128;
-    }
-    else
+IpPrefix::IpPrefix(uint32_t ipPrefix, int mask) : m_ip(ipPrefix), m_mask(mask)
+{
+    if (!isValid())
     {
-        try
-        {
-            m_mask = std::stoi(ipPrefixStr.substr(pos + 1));
-        }
-        catch(const std::logic_error& ex)
-        {
-            throw std::invalid_argument(std::string("Failed to convert mask: ") + ex.what());
-        }
-        
-        if (!isValid())
-        {
-            throw std::invalid_argument("Invalid IpPrefix from string");
-        }
+        throw std::invalid_argument("Invalid IpPrefix from prefix and mask");
     }
 }
 
-IpPrefix::IpPrefix(uint32_t ipPrefix, int mask) : m_ip(ipPrefix), m_mask(mask)
+IpPrefix::IpPrefix(const IpAddress &ip, int mask) : m_ip(ip), m_mask(mask)
 {
     if (!isValid())
     {
-        throw std::invalid_argument("Invalid IpPrefix from prefix and mask");
+        throw std::invalid_argument("Invalid IpPrefix from address and mask");
     }
 }
 
@@ -79,5 +59,81 @@ bool IpPrefix::isValid()
 
 std::string IpPrefix::to_string() const
 {
-    return (m_ip.to_string() + "/" + std::to_string(m_mask));
+    char buf[MAX_STRING_LEN];
+
+    return std::string(buf, format(buf));
+}
+
+bool IpPrefix::parse(const char *str, size_t len, IpPrefix &prefix)
+{
+    const char *slash = static_cast<const char *>(memchr(str, '/', len));
+    size_t ipLen = slash ? static_cast<size_t>(slash - str) : len;
+    IpAddress ip;
+
+    if (ipLen == 0)
+    {
+        ip = IpAddress(0);
+    }
+    else if (!IpAddress::parse(str, ipLen, ip))
+    {
+        return false;
+    }
+
+    int mask;
+
+    if (!slash)
+    {
+        mask = ip.isV4() ? 32 : 128;
+    }
+    else
+    {
+        const char *p = slash + 1;
+        const char *end = str + len;
+
+        /* Decimal length of up to 3 digits */
+        if (p == end || end - p > 3)
+        {
+            return false;
+        }
+
+        mask = 0;
+        for (; p != end; p++)
+        {
+            if (*p < '0' || *p > '9')
+            {
+                return false;
+            }
+            mask = mask * 10 + (*p - '0');
+        }
+    }
+
+    IpPrefix result;
+    result.m_ip = ip;
+    result.m_mask = mask;
+
+    if (!result.isValid())
+    {
+        return false;
+    }
+
+    prefix = result;
+    return true;
+}
+
+char *IpPrefix::format(char *buf) const
+{
+    buf = m_ip.format(buf);
+    *buf++ = '/';
+
+    if (m_mask >= 100)
+    {
+        *buf++ = static_cast<char>('0' + m_mask / 100);
+    }
+    if (m_mask >= 10)
+    {
+        *buf++ = static_cast<char>('0' + m_mask / 10 % 10);
+    }
+    *buf++ = static_cast<char>('0' + m_mask % 10);
+
+    return buf;
 }
@@ -14,6 +14,7 @@ public:
     IpPrefix() {}
     IpPrefix(const std::string &ipPrefixStr);
     IpPrefix(uint32_t addr, int mask);
+    IpPrefix(const IpAddress &ip, int mask);
 
     inline bool isV4() const
     {
@@ -31,21 +32,15 @@ public:
         {
             case AF_INET:
             {
-                return IpAddress((m_ip.getV4Addr()) | ~(getMask().getV4Addr()));
+                return IpAddress((m_ip.getV4Addr()) | ~getV4Mask(m_mask));
             }
             case AF_INET6:
             {
-                ip_addr_t ipa;
-                ipa.family = AF_INET6;
-                const uint8_t *prefix = m_ip.getV6Addr();
-                IpAddress ip6mask = getMask();
-                const uint8_t *mask = ip6mask.getV6Addr();
-
-                for (int i = 0; i < 16; ++i)
-                {
-                    ipa.ip_addr.ipv6_addr[i] = (uint8_t)(prefix[i] | ~mask[i]);
-                }
-                return IpAddress(ipa);
+                uint64_t words[2];
+                loadV6(m_ip, words);
+                words[0] |= ~getV6MaskWord(m_mask, 0);
+                words[1] |= ~getV6MaskWord(m_mask, 1);
+                return storeV6(words);
             }
             default:
             {
@@ -60,24 +55,13 @@ public:
         {
             case AF_INET:
             {
-                return IpAddress(htonl((uint32_t)((0xFFFFFFFFLL << (32 - m_mask)) & 0xFFFFFFFFLL)));
+                return IpAddress(getV4Mask(m_mask));
             }
             case AF_INET6:
             {
-                ip_addr_t ipa;
-                ipa.family = AF_INET6;
-
                 assert(m_mask >= 0 && m_mask <= 128);
-                int mid = m_mask >> 3;
-                int bits = m_mask & 0x7;
-                memset(ipa.ip_addr.ipv6_addr, 0xFF, mid);
-                if (mid < 16)
-                {
-                    assert(mid >= 0 && mid < 16);
-                    ipa.ip_addr.ipv6_addr[mid] = (uint8_t)(0xFF << (8 - bits));
-                    memset(ipa.ip_addr.ipv6_addr + mid + 1, 0, 16 - mid - 1);
-                }
-                return IpAddress(ipa);
+                uint64_t words[2] = { getV6MaskWord(m_mask, 0), getV6MaskWord(m_mask, 1) };
+                return storeV6(words);
             }
             default:
             {
@@ -107,25 +91,16 @@ public:
         {
             case AF_INET:
             {
-                uint32_t mask = getMask().getV4Addr();
-                return (m_ip.getV4Addr() & mask) == (addr.getV4Addr() & mask);
+                return ((m_ip.getV4Addr() ^ addr.getV4Addr()) & getV4Mask(m_mask)) == 0;
             }
             case AF_INET6:
             {
-                const uint8_t *prefix = m_ip.getV6Addr();
-                IpAddress ip6mask = getMask();
-                const uint8_t *mask = ip6mask.getV6Addr();
-                const uint8_t *ip = addr.getV6Addr();
-
-                for (int i = 0; i < 16; ++i)
-                {
-                    if ((prefix[i] & mask[i]) != (ip[i] & mask[i]))
-                    {
-                        return false;
-                    }
-                }
-
-                return true;
+                uint64_t prefix[2], ip[2];
+                loadV6(m_ip, prefix);
+                loadV6(addr, ip);
+
+                return (((prefix[0] ^ ip[0]) & getV6MaskWord(m_mask, 0)) |
+                        ((prefix[1] ^ ip[1]) & getV6MaskWord(m_mask, 1))) == 0;
             }
             default:
             {
@@ -140,34 +115,16 @@ public:
         {
             case AF_INET:
             {
-                uint32_t ipaddr = m_ip.getV4Addr();
-                uint32_t mask = getMask().getV4Addr();
-
-                ipaddr &= mask;
-                return IpPrefix(ipaddr, m_mask);
+                return IpPrefix(m_ip.getV4Addr() & getV4Mask(m_mask), m_mask);
             }
 
             case AF_INET6:
             {
-                const uint8_t *ipaddr = m_ip.getV6Addr();
-                uint8_t subnet[INET6_ADDRSTRLEN] = {0};
-                memcpy(subnet, ipaddr, 16);
-
-                IpAddress ip6mask = getMask();
-                const uint8_t *mask = ip6mask.getV6Addr();
-
-                for (int i = 0; i < 16; ++i)
-                {
-                    subnet[i] &= mask[i];
-                }
-
-                char buf[INET6_ADDRSTRLEN];
-                std::string ipStr(inet_ntop(AF_INET6,
-                                            &subnet,
-                                            buf,
-                                            INET6_ADDRSTRLEN));
-
-                return IpPrefix(ipStr + "/" + std::to_string(m_mask));
+                uint64_t words[2];
+                loadV6(m_ip, words);
+                words[0] &= getV6MaskWord(m_mask, 0);
+                words[1] &= getV6MaskWord(m_mask, 1);
+                return IpPrefix(storeV6(words), m_mask);
             }
 
             default:
@@ -177,6 +134,18 @@ public:
         }
     }
 
+    /* IPv4 mask of len bits, in network order */
+    static constexpr uint32_t getV4Mask(int len)
+    {
+        return IpAddress::toNetworkOrder(len <= 0 ? 0u : 0xffffffffu << (32 - len));
+    }
+
+    /* Word 0 or 1 of the IPv6 mask of len bits, in network order */
+    static constexpr uint64_t getV6MaskWord(int len, int word)
+    {
+        return IpAddress::toNetworkOrder(getMaskBits(len - 64 * word));
+    }
+
     inline bool operator<(const IpPrefix &o) const
     {
         if (m_mask != o.m_mask)
@@ -192,13 +161,57 @@ public:
 
     std::string to_string() const;
 
+    inline size_t hash() const
+    {
+        return static_cast<size_t>(hashCombine(m_ip.hash(), static_cast<uint64_t>(m_mask)));
+    }
+
+    static const size_t MAX_STRING_LEN = IpAddress::MAX_STRING_LEN + 4;
+
+    /* Same as IpAddress::parse(), the mask length defaults to the full address */
+    static bool parse(const char *str, size_t len, IpPrefix &prefix);
+
+    /* Same as IpAddress::format(), buf must have room for MAX_STRING_LEN characters */
+    char *format(char *buf) const;
+
 private:
     bool isValid();
 
+    static constexpr uint64_t getMaskBits(int bits)
+    {
+        return bits <= 0 ? 0ULL : bits >= 64 ? ~0ULL : ~0ULL << (64 - bits);
+    }
+
+    static inline void loadV6(const IpAddress &ip, uint64_t *words)
+    {
+        memcpy(words, ip.getV6Addr(), 16);
+    }
+
+    static inline IpAddress storeV6(const uint64_t *words)
+    {
+        ip_addr_t ip;
+        ip.family = AF_INET6;
+        memcpy(ip.ip_addr.ipv6_addr, words, 16);
+        return IpAddress(ip);
+    }
+
     IpAddress m_ip;
     int m_mask;
 };
 
 }
 
+namespace std {
+
+template <>
+struct hash<swss::IpPrefix>
+{
+    size_t operator()(const swss::IpPrefix &prefix) const
+    {
+        return prefix.hash();
+    }
+};
+
+}
+
 #endif
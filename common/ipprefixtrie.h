@@ -0,0 +1,460 @@
+#pragma once
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <stdint.h>
+#include <endian.h>
+#include "ipaddress.h"
+#include "ipprefix.h"
+
+namespace swss {
+
+/*
+ * Longest prefix match table of IpPrefix to T
+ *
+ * IPv4 and IPv6 prefixes are kept in two separate path-compressed binary
+ * tries, so insert, remove and lookup take at most 32 or 128 steps
+ * whatever the number of prefixes. Nodes live in one vector and refer to
+ * each other by index, freed nodes are reused.
+ *
+ * Prefixes are keyed by their subnet: 10.1.1.1/24 and 10.1.1.0/24 are the
+ * same entry. T must be default constructible.
+ */
+template <typename T>
+class IpPrefixTrie
+{
+public:
+    /* Returns false when the prefix was already present, its value is replaced */
+    bool insert(const IpPrefix &prefix, const T &value)
+    {
+        return trie(prefix).insert(Key(prefix.getIp()), prefix.getMaskLength(), value);
+    }
+
+    /* Returns false when the prefix was not present */
+    bool remove(const IpPrefix &prefix)
+    {
+        return trie(prefix).remove(Key(prefix.getIp()), prefix.getMaskLength());
+    }
+
+    /* Exact match */
+    T *find(const IpPrefix &prefix)
+    {
+        return trie(prefix).find(Key(prefix.getIp()), prefix.getMaskLength());
+    }
+
+    const T *find(const IpPrefix &prefix) const
+    {
+        return const_cast<IpPrefixTrie *>(this)->find(prefix);
+    }
+
+    /* Longest prefix covering addr, its subnet is stored in match if given */
+    T *lookup(const IpAddress &addr, IpPrefix *match = nullptr)
+    {
+        Trie &t = addr.isV4() ? m_v4 : m_v6;
+        Key key(addr);
+        int len;
+
+        T *value = t.lookup(key, len);
+        if (value && match)
+        {
+            *match = IpPrefix(key.toAddress(addr.isV4(), len), len);
+        }
+
+        return value;
+    }
+
+    const T *lookup(const IpAddress &addr, IpPrefix *match = nullptr) const
+    {
+        return const_cast<IpPrefixTrie *>(this)->lookup(addr, match);
+    }
+
+    /* Replace the content with entries, inserting them in address order */
+    void build(std::vector<std::pair<IpPrefix, T>> entries)
+    {
+        clear();
+
+        size_t v4 = 0;
+        for (const auto &e : entries)
+        {
+            v4 += e.first.isV4();
+        }
+
+        m_v4.reserve(2 * v4);
+        m_v6.reserve(2 * (entries.size() - v4));
+
+        std::sort(entries.begin(), entries.end(),
+                  [](const std::pair<IpPrefix, T> &a, const std::pair<IpPrefix, T> &b) {
+                      return a.first.getIp() < b.first.getIp();
+                  });
+
+        for (const auto &e : entries)
+        {
+            insert(e.first, e.second);
+        }
+    }
+
+    size_t size() const
+    {
+        return m_v4.size() + m_v6.size();
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    void clear()
+    {
+        m_v4.clear();
+        m_v6.clear();
+    }
+
+private:
+    /* Address bits, most significant first */
+    struct Key
+    {
+        uint64_t hi;
+        uint64_t lo;
+
+        Key() : hi(0), lo(0) {}
+
+        explicit Key(const IpAddress &addr)
+        {
+            if (addr.isV4())
+            {
+                hi = static_cast<uint64_t>(ntohl(addr.getV4Addr())) << 32;
+                lo = 0;
+            }
+            else
+            {
+                const unsigned char *bytes = addr.getV6Addr();
+                memcpy(&hi, bytes, 8);
+                memcpy(&lo, bytes + 8, 8);
+                hi = be64toh(hi);
+                lo = be64toh(lo);
+            }
+        }
+
+        IpAddress toAddress(bool v4, int len) const
+        {
+            Key k = masked(len);
+
+            if (v4)
+            {
+                return IpAddress(htonl(static_cast<uint32_t>(k.hi >> 32)));
+            }
+
+            ip_addr_t ip;
+            ip.family = AF_INET6;
+            uint64_t hiBe = htobe64(k.hi);
+            uint64_t loBe = htobe64(k.lo);
+            memcpy(ip.ip_addr.ipv6_addr, &hiBe, 8);
+            memcpy(ip.ip_addr.ipv6_addr + 8, &loBe, 8);
+            return IpAddress(ip);
+        }
+
+        int bit(int i) const
+        {
+            return i < 64 ? static_cast<int>((hi >> (63 - i)) & 1)
+                          : static_cast<int>((lo >> (127 - i)) & 1);
+        }
+
+        Key masked(int len) const
+        {
+            Key k;
+            if (len >= 64)
+            {
+                k.hi = hi;
+                k.lo = len == 64 ? 0 : lo & (~0ULL << (128 - len));
+            }
+            else
+            {
+                k.hi = len == 0 ? 0 : hi & (~0ULL << (64 - len));
+            }
+            return k;
+        }
+
+        /* Number of leading bits equal in both keys */
+        int common(const Key &o) const
+        {
+            uint64_t x = hi ^ o.hi;
+            if (x)
+            {
+                return __builtin_clzll(x);
+            }
+
+            x = lo ^ o.lo;
+            return x ? 64 + __builtin_clzll(x) : 128;
+        }
+    };
+
+    class Trie
+    {
+    public:
+        static const uint32_t NIL = UINT32_MAX;
+
+        Trie() : m_root(NIL), m_free(NIL), m_size(0) {}
+
+        bool insert(const Key &addr, int len, const T &value)
+        {
+            Key key = addr.masked(len);
+            uint32_t parent = NIL;
+            int side = 0;
+            uint32_t cur = m_root;
+
+            while (cur != NIL)
+            {
+                int common = std::min(std::min(key.common(m_nodes[cur].key), len), m_nodes[cur].len);
+
+                if (common == m_nodes[cur].len && common == len)
+                {
+                    bool added = !m_nodes[cur].hasValue;
+                    m_nodes[cur].value = value;
+                    m_nodes[cur].hasValue = true;
+                    m_size += added;
+                    return added;
+                }
+
+                if (common == m_nodes[cur].len)
+                {
+                    parent = cur;
+                    side = key.bit(common);
+                    cur = m_nodes[cur].child[side];
+                    continue;
+                }
+
+                /* The new prefix branches off above cur */
+                uint32_t node = alloc(key, len, &value);
+                if (common == len)
+                {
+                    m_nodes[node].child[m_nodes[cur].key.bit(len)] = cur;
+                }
+                else
+                {
+                    uint32_t glue = alloc(key.masked(common), common, nullptr);
+                    m_nodes[glue].child[key.bit(common)] = node;
+                    m_nodes[glue].child[m_nodes[cur].key.bit(common)] = cur;
+                    node = glue;
+                }
+
+                link(parent, side, node);
+                m_size++;
+                return true;
+            }
+
+            link(parent, side, alloc(key, len, &value));
+            m_size++;
+            return true;
+        }
+
+        bool remove(const Key &addr, int len)
+        {
+            Key key = addr.masked(len);
+            uint32_t grandparent = NIL, parent = NIL;
+            int parentSide = 0, side = 0;
+            uint32_t cur = m_root;
+
+            while (cur != NIL && m_nodes[cur].len < len)
+            {
+                if (key.common(m_nodes[cur].key) < m_nodes[cur].len)
+                {
+                    return false;
+                }
+
+                grandparent = parent;
+                parentSide = side;
+                parent = cur;
+                side = key.bit(m_nodes[cur].len);
+                cur = m_nodes[cur].child[side];
+            }
+
+            if (cur == NIL || m_nodes[cur].len != len || !m_nodes[cur].hasValue ||
+                key.common(m_nodes[cur].key) < len)
+            {
+                return false;
+            }
+
+            m_nodes[cur].value = T();
+            m_nodes[cur].hasValue = false;
+            m_size--;
+
+            uint32_t left = m_nodes[cur].child[0], right = m_nodes[cur].child[1];
+            if (left != NIL && right != NIL)
+            {
+                /* Still needed to branch */
+                return true;
+            }
+
+            link(parent, side, left != NIL ? left : right);
+            release(cur);
+
+            /* A valueless parent left with a single child is not needed either */
+            if (parent != NIL && !m_nodes[parent].hasValue)
+            {
+                uint32_t other = m_nodes[parent].child[side ^ 1];
+                if (m_nodes[parent].child[side] == NIL)
+                {
+                    link(grandparent, parentSide, other);
+                    release(parent);
+                }
+            }
+
+            return true;
+        }
+
+        T *find(const Key &addr, int len)
+        {
+            Key key = addr.masked(len);
+            uint32_t cur = m_root;
+
+            while (cur != NIL && m_nodes[cur].len <= len)
+            {
+                const Node &n = m_nodes[cur];
+
+                if (key.common(n.key) < n.len)
+                {
+                    return nullptr;
+                }
+
+                if (n.len == len)
+                {
+                    return n.hasValue ? &m_nodes[cur].value : nullptr;
+                }
+
+                cur = n.child[key.bit(n.len)];
+            }
+
+            return nullptr;
+        }
+
+        T *lookup(const Key &key, int &len)
+        {
+            uint32_t best = NIL;
+            uint32_t cur = m_root;
+
+            while (cur != NIL)
+            {
+                const Node &n = m_nodes[cur];
+
+                if (key.common(n.key) < n.len)
+                {
+                    break;
+                }
+
+                if (n.hasValue)
+                {
+                    best = cur;
+                }
+
+                if (n.len == 128)
+                {
+                    break;
+                }
+
+                cur = n.child[key.bit(n.len)];
+            }
+
+            if (best == NIL)
+            {
+                return nullptr;
+            }
+
+            len = m_nodes[best].len;
+            return &m_nodes[best].value;
+        }
+
+        void reserve(size_t nodes)
+        {
+            m_nodes.reserve(nodes);
+        }
+
+        size_t size() const
+        {
+            return m_size;
+        }
+
+        void clear()
+        {
+            m_nodes.clear();
+            m_root = NIL;
+            m_free = NIL;
+            m_size = 0;
+        }
+
+    private:
+        struct Node
+        {
+            Key key;
+            uint32_t child[2];
+            int len;
+            bool hasValue;
+            T value;
+        };
+
+        uint32_t alloc(const Key &key, int len, const T *value)
+        {
+            uint32_t index;
+
+            if (m_free != NIL)
+            {
+                index = m_free;
+                m_free = m_nodes[index].child[0];
+            }
+            else
+            {
+                if (m_nodes.size() >= NIL)
+                {
+                    throw std::length_error("IpPrefixTrie is full");
+                }
+
+                index = static_cast<uint32_t>(m_nodes.size());
+                m_nodes.emplace_back();
+            }
+
+            Node &n = m_nodes[index];
+            n.key = key;
+            n.len = len;
+            n.child[0] = n.child[1] = NIL;
+            n.hasValue = value != nullptr;
+            n.value = value ? *value : T();
+            return index;
+        }
+
+        /* Freed nodes are chained through child[0] */
+        void release(uint32_t index)
+        {
+            m_nodes[index].value = T();
+            m_nodes[index].child[0] = m_free;
+            m_free = index;
+        }
+
+        void link(uint32_t parent, int side, uint32_t node)
+        {
+            if (parent == NIL)
+            {
+                m_root = node;
+            }
+            else
+            {
+                m_nodes[parent].child[side] = node;
+            }
+        }
+
+        std::vector<Node> m_nodes;
+        uint32_t m_root;
+        uint32_t m_free;
+        size_t m_size;
+    };
+
+    Trie &trie(const IpPrefix &prefix)
+    {
+        return prefix.isV4() ? m_v4 : m_v6;
+    }
+
+    Trie m_v4;
+    Trie m_v6;
+};
+
+}
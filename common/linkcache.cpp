@@ -4,12 +4,60 @@
 #include <netlink/route/link.h>
 #include "common/logger.h"
 #include "common/linkcache.h"
+#include "common/netlink.h"
 
 using namespace std;
 using namespace swss;
 
-LinkCache::LinkCache()
+const int LinkCache::NEGATIVE_TTL_MS;
+const int LinkCache::REFILL_INTERVAL_MS;
+const int LinkCache::MAX_DENSE_IFINDEX;
+
+/* RTNLGRP_LINK subscription feeding the cache instead of NetDispatcher */
+class LinkCache::Updater : public NetLink
+{
+public:
+    Updater(LinkCache &cache) :
+        m_cache(cache)
+    {
+        registerGroup(RTNLGRP_LINK);
+    }
+
+protected:
+    void onMessage(struct nl_msg *msg) override
+    {
+        nl_msg_parse(msg, onObject, &m_cache);
+    }
+
+    void onOverrun() override
+    {
+        m_cache.refill();
+    }
+
+    /*
+     * Nothing goes through NetDispatcher, and lookups are made from within
+     * its handlers, which must not see their batches flushed
+     */
+    void flush() override
+    {
+    }
+
+private:
+    static void onObject(struct nl_object *obj, void *context)
+    {
+        ((LinkCache *)context)->onLinkUpdate(obj);
+    }
+
+    LinkCache &m_cache;
+};
+
+LinkCache::LinkCache() :
+    m_misses(MetricsRegistry::getInstance().getCounter("linkcache.misses")),
+    m_refills(MetricsRegistry::getInstance().getCounter("linkcache.refills"))
 {
+    /* Subscribed before dumping, so that no change is missed in between */
+    m_updater.reset(new Updater(*this));
+
     m_nl_sock = nl_socket_alloc();
     if (!m_nl_sock)
     {
@@ -38,6 +86,9 @@ LinkCache::LinkCache()
         throw system_error(make_error_code(errc::address_not_available),
                            "Unable to connect netlink socket");
     }
+
+    m_lastRefill = chrono::steady_clock::now();
+    nl_cache_foreach(m_link_cache, onCachedLink, this);
 }
 
 LinkCache::~LinkCache()
@@ -55,28 +106,129 @@ LinkCache &LinkCache::getInstance()
     return linkCache;
 }
 
+Selectable *LinkCache::getSelectable()
+{
+    return m_updater.get();
+}
+
+LinkCache::Entry *LinkCache::find(int ifindex)
+{
+    if (ifindex >= 0 && ifindex < MAX_DENSE_IFINDEX)
+    {
+        return static_cast<size_t>(ifindex) < m_links.size() ? &m_links[ifindex] : NULL;
+    }
+
+    return m_sparseLinks.find(ifindex);
+}
+
+LinkCache::Entry &LinkCache::get(int ifindex)
+{
+    if (ifindex >= 0 && ifindex < MAX_DENSE_IFINDEX)
+    {
+        if (static_cast<size_t>(ifindex) >= m_links.size())
+            m_links.resize(static_cast<size_t>(ifindex) + 1);
+        return m_links[ifindex];
+    }
+
+    return m_sparseLinks[ifindex];
+}
+
+void LinkCache::onLinkUpdate(struct nl_object *obj)
+{
+    struct rtnl_link *link = (struct rtnl_link *)obj;
+
+    /* Bridge port updates share the group, the cache holds the links themselves */
+    if (rtnl_link_get_family(link) != AF_UNSPEC)
+        return;
+
+    nl_cache_include(m_link_cache, obj, NULL, NULL);
+
+    int ifindex = rtnl_link_get_ifindex(link);
+    if (nl_object_get_msgtype(obj) == RTM_DELLINK)
+    {
+        Entry *entry = find(ifindex);
+        if (entry)
+            entry->name.clear();
+        return;
+    }
+
+    const char *name = rtnl_link_get_name(link);
+    if (name)
+        get(ifindex).name = name;
+}
+
+void LinkCache::onCachedLink(struct nl_object *obj, void *context)
+{
+    struct rtnl_link *link = (struct rtnl_link *)obj;
+    LinkCache *cache = (LinkCache *)context;
+    const char *name = rtnl_link_get_name(link);
+
+    if (name)
+        cache->get(rtnl_link_get_ifindex(link)).name = name;
+}
+
+void LinkCache::refill()
+{
+    m_refills.inc();
+    m_lastRefill = chrono::steady_clock::now();
+
+    int err = nl_cache_refill(m_nl_sock, m_link_cache);
+    if (err < 0)
+    {
+        SWSS_LOG_ERROR("Unable to refill link cache: %s", nl_geterror(err));
+        return;
+    }
+
+    m_links.clear();
+    m_sparseLinks.clear();
+    nl_cache_foreach(m_link_cache, onCachedLink, this);
+}
+
 string LinkCache::ifindexToName(int ifindex)
 {
-#define MAX_ADDR_SIZE 128
-    char addrStr[MAX_ADDR_SIZE + 1] = {0};
+    Entry *entry = find(ifindex);
+    if (entry && !entry->name.empty())
+    {
+        return entry->name;
+    }
 
-    if (rtnl_link_i2name(m_link_cache, ifindex, addrStr, MAX_ADDR_SIZE) == NULL)
+    auto now = chrono::steady_clock::now();
+    if (entry && now - entry->missed < chrono::milliseconds(NEGATIVE_TTL_MS))
     {
-        /* Trying to refill cache */
-        nl_cache_refill(m_nl_sock ,m_link_cache);
-        if (rtnl_link_i2name(m_link_cache, ifindex,
-                             addrStr, MAX_ADDR_SIZE) == NULL)
+        return to_string(ifindex);
+    }
+
+    m_misses.inc();
+
+    /* The link may have just been created, with its update still unread */
+    m_updater->readData();
+
+    if (!(entry = find(ifindex)) || entry->name.empty())
+    {
+        if (now - m_lastRefill >= chrono::milliseconds(REFILL_INTERVAL_MS))
+        {
+            refill();
+        }
+
+        if (!(entry = find(ifindex)) || entry->name.empty())
         {
             /* Returns ifindex as string / */
+            get(ifindex).missed = now;
             return to_string(ifindex);
         }
-
     }
 
-    return string(addrStr);
+    return entry->name;
 }
 
 struct rtnl_link* LinkCache::getLinkByName(const char *name)
 {
-    return rtnl_link_get_by_name(m_link_cache, name);
+    struct rtnl_link *link = rtnl_link_get_by_name(m_link_cache, name);
+    if (link == NULL)
+    {
+        m_updater->readData();
+        link = rtnl_link_get_by_name(m_link_cache, name);
+    }
+
+    return link;
 }
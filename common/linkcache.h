@@ -7,24 +7,72 @@
 #include <netlink/data.h>
 #include <netlink/route/rtnl.h>
 #include <netlink/route/link.h>
+#include <chrono>
+#include <memory>
 #include <string>
+#include <vector>
+#include "flathashmap.h"
+#include "metrics.h"
 
 namespace swss {
 
+class Selectable;
+
+/*
+ * Links of the host, kept current by RTNLGRP_LINK updates rather than by
+ * dumping them again on lookup misses
+ *
+ * Updates are applied as they arrive when getSelectable() is part of the
+ * daemon's Select, and otherwise when a lookup misses. Missing ifindexes
+ * are remembered for NEGATIVE_TTL_MS, and a lookup miss refills the whole
+ * cache at most every REFILL_INTERVAL_MS, in case updates were lost.
+ */
 class LinkCache {
 public:
+    static const int NEGATIVE_TTL_MS = 1000;
+    static const int REFILL_INTERVAL_MS = 1000;
+
     static LinkCache &getInstance();
 
     /* Translate ifindex to name */
     std::string ifindexToName(int ifindex);
     struct rtnl_link* getLinkByName(const char* name);
 
+    Selectable *getSelectable();
+
 private:
     LinkCache();
     ~LinkCache();
 
+    class Updater;
+
+    /* Names of ifindexes below this are kept in a vector indexed by them */
+    static const int MAX_DENSE_IFINDEX = 65536;
+
+    struct Entry
+    {
+        std::string name;
+        /* Lookup missed since then, while name is empty */
+        std::chrono::steady_clock::time_point missed;
+    };
+
+    Entry *find(int ifindex);
+    Entry &get(int ifindex);
+
+    void onLinkUpdate(struct nl_object *obj);
+    void refill();
+    static void onCachedLink(struct nl_object *obj, void *context);
+
     nl_cache *m_link_cache;
     nl_sock *m_nl_sock;
+
+    std::unique_ptr<Updater> m_updater;
+    std::vector<Entry> m_links;
+    FlatHashMap<int, Entry> m_sparseLinks;
+    std::chrono::steady_clock::time_point m_lastRefill;
+
+    Counter &m_misses;
+    Counter &m_refills;
 };
 
 }
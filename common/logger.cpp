@@ -8,19 +8,315 @@
 #include <sstream>
 #include <iomanip>
 #include <stdexcept>
+#include <condition_variable>
+#include <vector>
 #include "schema.h"
 #include "select.h"
 #include "dbconnector.h"
 #include "redisclient.h"
 #include "consumerstatetable.h"
 #include "producerstatetable.h"
+#include "metrics.h"
 
 namespace swss {
 
+/*
+ * Ring of formatted messages, written by one thread and drained by the
+ * asynchronous writer
+ */
+class LogRing
+{
+public:
+    struct Record
+    {
+        Logger::Priority prio;
+        char text[Logger::MAX_ASYNC_MESSAGE];
+    };
+
+    LogRing(size_t size) :
+        m_records(size),
+        m_head(0),
+        m_tail(0),
+        m_orphaned(false)
+    {
+    }
+
+    bool push(Logger::Priority prio, const char *fmt, va_list ap)
+#ifdef __GNUC__
+        __attribute__ ((format (printf, 3, 0)))
+#endif
+    {
+        size_t head = m_head.load(std::memory_order_relaxed);
+
+        if (head - m_tail.load(std::memory_order_acquire) == m_records.size())
+        {
+            return false;
+        }
+
+        Record &record = m_records[head % m_records.size()];
+        record.prio = prio;
+        vsnprintf(record.text, sizeof(record.text), fmt, ap);
+
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    const Record *front()
+    {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+
+        if (tail == m_head.load(std::memory_order_acquire))
+        {
+            return nullptr;
+        }
+
+        return &m_records[tail % m_records.size()];
+    }
+
+    void pop()
+    {
+        m_tail.store(m_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /* Set when the owning thread exits, the writer frees the ring once drained */
+    void orphan()
+    {
+        m_orphaned.store(true, std::memory_order_release);
+    }
+
+    bool isOrphaned() const
+    {
+        return m_orphaned.load(std::memory_order_acquire);
+    }
+
+private:
+    std::vector<Record> m_records;
+    std::atomic<size_t> m_head;
+    std::atomic<size_t> m_tail;
+    std::atomic<bool> m_orphaned;
+};
+
+namespace {
+
+/*
+ * Set once the thread's ring is handed over to the writer. Trivially
+ * destructible, so still valid for logging later in the TLS teardown.
+ */
+thread_local bool t_logRingGone = false;
+
+struct LogRingHandle
+{
+    LogRing *ring = nullptr;
+
+    ~LogRingHandle()
+    {
+        if (ring)
+        {
+            ring->orphan();
+            ring = nullptr;
+        }
+        t_logRingGone = true;
+    }
+};
+
+thread_local LogRingHandle t_logRing;
+
+}
+
+class Logger::AsyncWriter
+{
+public:
+    static const int IDLE_WAIT_MS = 10;
+
+    AsyncWriter(Logger &logger) :
+        m_logger(logger),
+        m_dropped(MetricsRegistry::getInstance().getCounter("logger.dropped")),
+        m_written(MetricsRegistry::getInstance().getCounter("logger.async_written")),
+        m_ringSize(DEFAULT_ASYNC_RING_SIZE),
+        m_stop(false),
+        m_passes(0),
+        m_thread(&AsyncWriter::run, this)
+    {
+    }
+
+    void setRingSize(size_t size)
+    {
+        m_ringSize.store(size, std::memory_order_relaxed);
+    }
+
+    /* false if the thread is exiting and has no ring anymore, ap is untouched */
+    bool write(Priority prio, const char *fmt, va_list ap)
+#ifdef __GNUC__
+        __attribute__ ((format (printf, 3, 0)))
+#endif
+    {
+        if (t_logRingGone)
+        {
+            return false;
+        }
+
+        if (!t_logRing.ring)
+        {
+            std::unique_ptr<LogRing> ring(new LogRing(m_ringSize.load(std::memory_order_relaxed)));
+            t_logRing.ring = ring.get();
+
+            std::lock_guard<std::mutex> lock(m_ringsMutex);
+            m_rings.push_back(std::move(ring));
+        }
+
+        if (!t_logRing.ring->push(prio, fmt, ap))
+        {
+            m_dropped.inc();
+        }
+
+        return true;
+    }
+
+    /* Wait for a complete drain pass started after the call */
+    void flush()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        uint64_t target = m_passes + 2;
+
+        m_wakeup.notify_one();
+        m_passed.wait(lock, [&]{ return m_passes >= target || m_stop; });
+    }
+
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+            m_wakeup.notify_one();
+        }
+
+        m_thread.join();
+    }
+
+    uint64_t getDropped() const
+    {
+        return m_dropped.get();
+    }
+
+private:
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        while (true)
+        {
+            bool stop = m_stop;
+
+            lock.unlock();
+            bool busy = drain();
+            lock.lock();
+
+            m_passes++;
+            m_passed.notify_all();
+
+            if (stop)
+            {
+                break;
+            }
+
+            if (!busy)
+            {
+                m_wakeup.wait_for(lock, std::chrono::milliseconds(IDLE_WAIT_MS));
+            }
+        }
+    }
+
+    bool drain()
+    {
+        std::vector<LogRing *> rings;
+
+        {
+            std::lock_guard<std::mutex> lock(m_ringsMutex);
+
+            for (auto it = m_rings.begin(); it != m_rings.end();)
+            {
+                /* Orphaned first, so nothing gets pushed once it is seen empty */
+                if ((*it)->isOrphaned() && !(*it)->front())
+                {
+                    it = m_rings.erase(it);
+                    continue;
+                }
+
+                rings.push_back(it->get());
+                ++it;
+            }
+        }
+
+        bool busy = false;
+
+        for (auto ring : rings)
+        {
+            const LogRing::Record *record;
+
+            while ((record = ring->front()) != nullptr)
+            {
+                output(*record);
+                ring->pop();
+                m_written.inc();
+                busy = true;
+            }
+        }
+
+        return busy;
+    }
+
+    void output(const LogRing::Record &record)
+    {
+        Output out = m_logger.m_output;
+
+        if (out == SWSS_SYSLOG)
+        {
+            syslog(record.prio, "%s", record.text);
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(m_logger.m_mutex);
+            fprintf(out == SWSS_STDOUT ? stdout : stderr, "%6s%s\n",
+                    priorityToString(record.prio).c_str(), record.text);
+        }
+    }
+
+    Logger &m_logger;
+    Counter &m_dropped;
+    Counter &m_written;
+    std::atomic<size_t> m_ringSize;
+
+    std::mutex m_ringsMutex;
+    std::vector<std::unique_ptr<LogRing>> m_rings;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    std::condition_variable m_passed;
+    bool m_stop;
+    uint64_t m_passes;
+
+    std::thread m_thread;
+};
+
+std::atomic<Logger::Priority> Logger::m_minPrio(SWSS_NOTICE);
+
+const size_t Logger::DEFAULT_ASYNC_RING_SIZE;
+const size_t Logger::MAX_ASYNC_MESSAGE;
+const int Logger::AsyncWriter::IDLE_WAIT_MS;
+
+Logger::Logger() {
+}
+
 Logger::~Logger() {
     if (m_settingThread) {
         m_settingThread->detach();
     }
+
+    if (m_asyncWriter) {
+        m_async = false;
+        // Threads still running at exit may hold the writer and a ring, keep them allocated
+        m_asyncWriter->stop();
+    }
 }
 
 const Logger::PriorityStringMap Logger::priorityStringMap = {
@@ -151,6 +447,57 @@ Logger::Priority Logger::getMinPrio()
     return getInstance().m_minPrio;
 }
 
+void Logger::setAsync(bool async, size_t ringSize)
+{
+    auto& logger = getInstance();
+    std::lock_guard<std::mutex> lock(logger.m_asyncMutex);
+
+    if (async)
+    {
+        if (ringSize == 0)
+        {
+            throw std::invalid_argument("Logger::setAsync: ring size must not be 0");
+        }
+
+        if (!logger.m_asyncWriter)
+        {
+            logger.m_asyncWriter = new AsyncWriter(logger);
+        }
+
+        logger.m_asyncWriter->setRingSize(ringSize);
+        logger.m_async.store(true, std::memory_order_release);
+    }
+    else if (logger.m_async)
+    {
+        logger.m_async.store(false, std::memory_order_release);
+        logger.m_asyncWriter->flush();
+    }
+}
+
+bool Logger::isAsync()
+{
+    return getInstance().m_async;
+}
+
+void Logger::flush()
+{
+    auto& logger = getInstance();
+    std::lock_guard<std::mutex> lock(logger.m_asyncMutex);
+
+    if (logger.m_asyncWriter)
+    {
+        logger.m_asyncWriter->flush();
+    }
+}
+
+uint64_t Logger::getDroppedCount()
+{
+    auto& logger = getInstance();
+    std::lock_guard<std::mutex> lock(logger.m_asyncMutex);
+
+    return logger.m_asyncWriter ? logger.m_asyncWriter->getDropped() : 0;
+}
+
 [[ noreturn ]] void Logger::settingThread()
 {
     Select select;
@@ -216,6 +563,13 @@ void Logger::write(Priority prio, const char *fmt, ...)
     va_list ap;
     va_start(ap, fmt);
 
+    /* Synchronous once the thread's ring is gone, during its TLS teardown */
+    if (m_async.load(std::memory_order_acquire) && m_asyncWriter->write(prio, fmt, ap))
+    {
+        va_end(ap);
+        return;
+    }
+
     if (m_output == SWSS_SYSLOG)
     {
             vsyslog(prio, fmt, ap);
@@ -243,6 +597,12 @@ void Logger::wthrow(Priority prio, const char *fmt, ...)
 {
     char buffer[0x1000];
 
+    // Output what is queued first so the error comes last
+    if (m_async)
+    {
+        flush();
+    }
+
     va_list ap;
     va_start(ap, fmt);
 
@@ -301,12 +661,12 @@ std::string Logger::outputToString(Logger::Output output)
     return "UNKNOWN";
 }
 
-Logger::ScopeLogger::ScopeLogger(int line, const char *fun) : m_line(line), m_fun(fun)
+void Logger::ScopeLogger::enter()
 {
     swss::Logger::getInstance().write(swss::Logger::SWSS_DEBUG, ":> %s: enter", m_fun);
 }
 
-Logger::ScopeLogger::~ScopeLogger()
+void Logger::ScopeLogger::leave()
 {
     swss::Logger::getInstance().write(swss::Logger::SWSS_DEBUG, ":< %s: exit", m_fun);
 }
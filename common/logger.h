@@ -11,13 +11,33 @@
 
 namespace swss {
 
-#define SWSS_LOG_ERROR(MSG, ...)       swss::Logger::getInstance().write(swss::Logger::SWSS_ERROR,  ":- %s: " MSG, __FUNCTION__, ##__VA_ARGS__)
-#define SWSS_LOG_WARN(MSG, ...)        swss::Logger::getInstance().write(swss::Logger::SWSS_WARN,   ":- %s: " MSG, __FUNCTION__, ##__VA_ARGS__)
-#define SWSS_LOG_NOTICE(MSG, ...)      swss::Logger::getInstance().write(swss::Logger::SWSS_NOTICE, ":- %s: " MSG, __FUNCTION__, ##__VA_ARGS__)
-#define SWSS_LOG_INFO(MSG, ...)        swss::Logger::getInstance().write(swss::Logger::SWSS_INFO,   ":- %s: " MSG, __FUNCTION__, ##__VA_ARGS__)
-#define SWSS_LOG_DEBUG(MSG, ...)       swss::Logger::getInstance().write(swss::Logger::SWSS_DEBUG,  ":- %s: " MSG, __FUNCTION__, ##__VA_ARGS__)
+/*
+ * Messages less important than SWSS_LOG_MAX_PRIO (a syslog level number,
+ * 7 for DEBUG) are removed at compile time, e.g. -DSWSS_LOG_MAX_PRIO=5
+ * drops DEBUG and INFO messages and SWSS_LOG_ENTER entirely.
+ */
+#ifndef SWSS_LOG_MAX_PRIO
+#define SWSS_LOG_MAX_PRIO 7
+#endif
+
+/* Arguments are only evaluated when the message is to be written */
+#define SWSS_LOG_PRIO(PRIO, MSG, ...) \
+    do { \
+        if ((PRIO) <= SWSS_LOG_MAX_PRIO && swss::Logger::isEnabled(PRIO)) \
+            swss::Logger::getInstance().write(PRIO, ":- %s: " MSG, __FUNCTION__, ##__VA_ARGS__); \
+    } while (0)
 
+#define SWSS_LOG_ERROR(MSG, ...)       SWSS_LOG_PRIO(swss::Logger::SWSS_ERROR,  MSG, ##__VA_ARGS__)
+#define SWSS_LOG_WARN(MSG, ...)        SWSS_LOG_PRIO(swss::Logger::SWSS_WARN,   MSG, ##__VA_ARGS__)
+#define SWSS_LOG_NOTICE(MSG, ...)      SWSS_LOG_PRIO(swss::Logger::SWSS_NOTICE, MSG, ##__VA_ARGS__)
+#define SWSS_LOG_INFO(MSG, ...)        SWSS_LOG_PRIO(swss::Logger::SWSS_INFO,   MSG, ##__VA_ARGS__)
+#define SWSS_LOG_DEBUG(MSG, ...)       SWSS_LOG_PRIO(swss::Logger::SWSS_DEBUG,  MSG, ##__VA_ARGS__)
+
+#if SWSS_LOG_MAX_PRIO >= 7
 #define SWSS_LOG_ENTER()               swss::Logger::ScopeLogger logger ## __LINE__ (__LINE__, __FUNCTION__)
+#else
+#define SWSS_LOG_ENTER()               do { } while (0)
+#endif
 #define SWSS_LOG_TIMER(msg, ...)       swss::Logger::ScopeTimer scopetimer ## __LINE__ (__LINE__, __FUNCTION__, msg, ##__VA_ARGS__)
 
 #define SWSS_LOG_THROW(MSG, ...)       swss::Logger::getInstance().wthrow(swss::Logger::SWSS_ERROR,  ":- %s: " MSG, __FUNCTION__, ##__VA_ARGS__)
@@ -55,6 +75,12 @@ public:
     static Logger &getInstance();
     static void setMinPrio(Priority prio);
     static Priority getMinPrio();
+
+    static inline bool isEnabled(Priority prio)
+    {
+        return prio <= m_minPrio.load(std::memory_order_relaxed);
+    }
+
     static void linkToDbWithOutput(const std::string &dbName, const PriorityChangeNotify& prioNotify, const std::string& defPrio, const OutputChangeNotify& outputNotify, const std::string& defOutput);
     static void linkToDb(const std::string &dbName, const PriorityChangeNotify& notify, const std::string& defPrio);
     // Must be called after all linkToDb to start select from DB
@@ -72,6 +98,26 @@ public:
 #endif
     ;
 
+    static const size_t DEFAULT_ASYNC_RING_SIZE = 256;
+    static const size_t MAX_ASYNC_MESSAGE = 512;
+
+    /*
+     * Switch output to a background writer thread
+     *
+     * Messages are formatted into a lock-free ring owned by the calling
+     * thread (ringSize entries, created on its first message) and output by
+     * the writer, so logging never blocks. When a ring is full the message
+     * is dropped and counted, messages longer than MAX_ASYNC_MESSAGE are
+     * truncated.
+     */
+    static void setAsync(bool async, size_t ringSize = DEFAULT_ASYNC_RING_SIZE);
+    static bool isAsync();
+
+    /* Wait until the messages written so far are output */
+    static void flush();
+
+    static uint64_t getDroppedCount();
+
     static std::string priorityToString(Priority prio);
     static std::string outputToString(Output output);
 
@@ -79,12 +125,32 @@ public:
     {
         public:
 
-        ScopeLogger(int line, const char *fun);
-        ~ScopeLogger();
+        ScopeLogger(int line, const char *fun) :
+            m_line(line),
+            m_fun(fun),
+            m_enabled(isEnabled(SWSS_DEBUG))
+        {
+            if (m_enabled)
+            {
+                enter();
+            }
+        }
+
+        ~ScopeLogger()
+        {
+            if (m_enabled)
+            {
+                leave();
+            }
+        }
 
         private:
+            void enter();
+            void leave();
+
             const int m_line;
             const char *m_fun;
+            const bool m_enabled;
     };
 
     class ScopeTimer
@@ -107,7 +173,9 @@ public:
     };
 
 private:
-    Logger(){};
+    class AsyncWriter;
+
+    Logger();
     ~Logger();
     Logger(const Logger&);
     Logger &operator=(const Logger&);
@@ -118,11 +186,15 @@ private:
 
     LogSettingChangeObservers m_settingChangeObservers;
     std::map<std::string, std::string> m_currentPrios;
-    std::atomic<Priority> m_minPrio = { SWSS_NOTICE };
+    static std::atomic<Priority> m_minPrio;
     std::map<std::string, std::string> m_currentOutputs;
     std::atomic<Output> m_output = { SWSS_SYSLOG };
     std::unique_ptr<std::thread> m_settingThread;
     std::mutex m_mutex;
+    std::atomic<bool> m_async = { false };
+    /* Never freed nor cleared, threads logging at exit may still use it */
+    AsyncWriter *m_asyncWriter = nullptr;
+    std::mutex m_asyncMutex;
 };
 
 }
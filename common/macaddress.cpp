@@ -5,7 +5,7 @@
 using namespace swss;
 using namespace std;
 
-const size_t mac_address_str_length = ETHER_ADDR_LEN*2 + 5; // 6 hexadecimal numbers (two digits each) + 5 delimiters
+const size_t MacAddress::STRING_LEN;
 
 MacAddress::MacAddress()
 {
@@ -28,22 +28,65 @@ const std::string MacAddress::to_string() const
     return MacAddress::to_string(m_mac);
 }
 
+/* "00" to "ff", two characters per byte value */
+static const char hexPairs[] =
+    "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"
+    "202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f"
+    "404142434445464748494a4b4c4d4e4f505152535455565758595a5b5c5d5e5f"
+    "606162636465666768696a6b6c6d6e6f707172737475767778797a7b7c7d7e7f"
+    "808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f"
+    "a0a1a2a3a4a5a6a7a8a9aaabacadaeafb0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+    "c0c1c2c3c4c5c6c7c8c9cacbcccdcecfd0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+    "e0e1e2e3e4e5e6e7e8e9eaebecedeeeff0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+
+/* Value of a hex digit, 0xf0 for other characters */
+static const uint8_t hexValues[256] = {
+    0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0,
+    0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0,
+    0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0,
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0,
+    0xf0, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0,
+    0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0,
+    0xf0, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0,
+    0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0,
+    0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0,
+    0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0,
+    0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0,
+    0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0,
+    0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0,
+    0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0,
+    0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0,
+    0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0
+};
+
 std::string MacAddress::to_string(const uint8_t* mac)
 {
-    const static char char_table[] = "0123456789abcdef";
+    char buf[STRING_LEN];
+
+    return std::string(buf, format(mac, buf));
+}
+
+char *MacAddress::format(const uint8_t *mac, char *buf)
+{
+    for (int i = 0; i < ETHER_ADDR_LEN - 1; ++i)
+    {
+        memcpy(buf, hexPairs + 2 * mac[i], 2);
+        buf[2] = ':';
+        buf += 3;
+    }
 
-    std::string str(mac_address_str_length, ':');
-    for(int i = 0; i < ETHER_ADDR_LEN; ++i) {
-        int left = i * 3;      // left  digit position of hexadecimal number
-        int right = left + 1;  // right digit position of hexadecimal number
-        int left_half  = mac[i] >> 4;
-        int right_half = mac[i] & 0x0f;
+    memcpy(buf, hexPairs + 2 * mac[ETHER_ADDR_LEN - 1], 2);
+    return buf + 2;
+}
 
-        str[left]  = char_table[left_half];
-        str[right] = char_table[right_half];
+char *MacAddress::format(const MacAddress *macs, size_t count, char *buf)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        buf = format(macs[i].m_mac, buf);
     }
 
-    return str;
+    return buf;
 }
 
 // This function parses a string to a binary mac address (uint8_t[6])
@@ -56,70 +99,67 @@ bool MacAddress::parseMacString(const string& str_mac, uint8_t* bin_mac)
         return false;
     }
 
-    if (str_mac.length() != mac_address_str_length)
+    return parse(str_mac.data(), str_mac.length(), bin_mac);
+}
+
+bool MacAddress::parse(const char *str, size_t len, uint8_t *mac)
+{
+    if (len != STRING_LEN)
     {
         return false;
     }
 
-    const char* ptr_mac = str_mac.c_str();
-
-    // first check that all mac address separators are equal to each other
+    // all separators must be equal to each other, and either ':' or '-'
     // 2, 5, 8, 11, and 14 are MAC address separator positions
-    if (!(ptr_mac[2]  == ptr_mac[5]
-       && ptr_mac[5]  == ptr_mac[8]
-       && ptr_mac[8]  == ptr_mac[11]
-       && ptr_mac[11] == ptr_mac[14]))
+    char sep = str[2];
+    if ((sep != ':' && sep != '-') ||
+        str[5] != sep || str[8] != sep || str[11] != sep || str[14] != sep)
     {
         return false;
     }
 
-    // then check that the first separator is equal to ':' or '-'
-    if (ptr_mac[2] != ':' && ptr_mac[2] != '-')
+    // Invalid digits have high bits set, check them once at the end
+    uint8_t bytes[ETHER_ADDR_LEN];
+    unsigned int invalid = 0;
+
+    for (int i = 0; i < ETHER_ADDR_LEN; ++i)
     {
-        return false;
+        uint8_t left = hexValues[static_cast<unsigned char>(str[i * 3])];
+        uint8_t right = hexValues[static_cast<unsigned char>(str[i * 3 + 1])];
+
+        invalid |= left | right;
+        bytes[i] = static_cast<uint8_t>(left << 4 | right);
     }
 
-    for(int i = 0; i < ETHER_ADDR_LEN; ++i)
+    if (invalid & 0xf0)
     {
-        int left  = i * 3;    // left  digit position of hexadecimal number
-        int right = left + 1; // right digit position of hexadecimal number
+        return false;
+    }
 
-        if (ptr_mac[left] >= '0' && ptr_mac[left] <= '9')
-        {
-            bin_mac[i] = static_cast<uint8_t>(ptr_mac[left] - '0');
-        }
-        else if (ptr_mac[left] >= 'A' && ptr_mac[left] <= 'F')
-        {
-            bin_mac[i] = static_cast<uint8_t>(ptr_mac[left] - 'A' + 0x0a);
-        }
-        else if (ptr_mac[left] >= 'a' && ptr_mac[left] <= 'f')
-        {
-            bin_mac[i] = static_cast<uint8_t>(ptr_mac[left] - 'a' + 0x0a);
-        }
-        else
-        {
-            return false;
-        }
+    memcpy(mac, bytes, ETHER_ADDR_LEN);
+    return true;
+}
 
-        bin_mac[i] = static_cast<uint8_t>(bin_mac[i] << 4);
+size_t MacAddress::parse(const char *const *strs, const size_t *lens, size_t count, MacAddress *macs, bool *valid)
+{
+    size_t parsed = 0;
 
-        if (ptr_mac[right] >= '0' && ptr_mac[right] <= '9')
-        {
-            bin_mac[i] |= static_cast<uint8_t>(ptr_mac[right] - '0');
-        }
-        else if (ptr_mac[right] >= 'A' && ptr_mac[right] <= 'F')
-        {
-            bin_mac[i] |= static_cast<uint8_t>(ptr_mac[right] - 'A' + 0x0a);
-        }
-        else if (ptr_mac[right] >= 'a' && ptr_mac[right] <= 'f')
+    for (size_t i = 0; i < count; ++i)
+    {
+        bool ok = parse(strs[i], lens[i], macs[i].m_mac);
+
+        if (!ok)
         {
-            bin_mac[i] |= static_cast<uint8_t>(ptr_mac[right] - 'a' + 0x0a);
+            memset(macs[i].m_mac, 0, ETHER_ADDR_LEN);
         }
-        else
+
+        if (valid)
         {
-            return false;
+            valid[i] = ok;
         }
+
+        parsed += ok;
     }
 
-    return true;
+    return parsed;
 }
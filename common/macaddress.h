@@ -5,6 +5,8 @@
 #include <string.h>
 #include <stdint.h>
 #include <string>
+#include <functional>
+#include "hash.h"
 
 namespace swss {
 
@@ -56,14 +58,54 @@ public:
 
     const std::string to_string() const;
 
+    inline size_t hash() const
+    {
+        uint64_t value = 0;
+        memcpy(&value, m_mac, ETHER_ADDR_LEN);
+        return static_cast<size_t>(hashMix(value));
+    }
+
     static std::string to_string(const uint8_t* mac);
 
     static bool parseMacString(const std::string& strmac, uint8_t* mac);
 
+    /* 6 hexadecimal numbers (two digits each) + 5 delimiters */
+    static const size_t STRING_LEN = ETHER_ADDR_LEN * 2 + 5;
+
+    /* Same rules as parseMacString() for the len characters at str */
+    static bool parse(const char *str, size_t len, uint8_t *mac);
+
+    /*
+     * Parse count addresses, strs[i] being lens[i] characters long. Invalid
+     * ones are zeroed and flagged false in valid, if given. Returns the
+     * number of valid addresses.
+     */
+    static size_t parse(const char *const *strs, const size_t *lens, size_t count,
+                        MacAddress *macs, bool *valid = nullptr);
+
+    /* Write the STRING_LEN characters of mac at buf and return their end, no NUL is added */
+    static char *format(const uint8_t *mac, char *buf);
+
+    /* Same for count addresses, written back to back */
+    static char *format(const MacAddress *macs, size_t count, char *buf);
+
 private:
     uint8_t m_mac[ETHER_ADDR_LEN];
 };
 
 }
 
+namespace std {
+
+template <>
+struct hash<swss::MacAddress>
+{
+    size_t operator()(const swss::MacAddress &mac) const
+    {
+        return mac.hash();
+    }
+};
+
+}
+
 #endif
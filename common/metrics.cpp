@@ -0,0 +1,126 @@
+#include <string>
+#include <vector>
+#include <sstream>
+#include "table.h"
+#include "metrics.h"
+
+using namespace std;
+
+namespace swss {
+
+MetricsRegistry &MetricsRegistry::getInstance()
+{
+    static MetricsRegistry registry;
+    return registry;
+}
+
+template <typename T>
+static T &getMetric(map<string, unique_ptr<T>> &metrics, const string &name)
+{
+    auto &metric = metrics[name];
+    if (!metric)
+    {
+        metric.reset(new T());
+    }
+    return *metric;
+}
+
+Counter &MetricsRegistry::getCounter(const string &name)
+{
+    lock_guard<mutex> lock(m_mutex);
+    return getMetric(m_counters, name);
+}
+
+Gauge &MetricsRegistry::getGauge(const string &name)
+{
+    lock_guard<mutex> lock(m_mutex);
+    return getMetric(m_gauges, name);
+}
+
+Histogram &MetricsRegistry::getHistogram(const string &name)
+{
+    lock_guard<mutex> lock(m_mutex);
+    return getMetric(m_histograms, name);
+}
+
+static vector<FieldValueTuple> histogramFields(const Histogram &h)
+{
+    vector<FieldValueTuple> fields;
+    fields.emplace_back("count", to_string(h.getCount()));
+    fields.emplace_back("sum", to_string(h.getSum()));
+    fields.emplace_back("max", to_string(h.getMax()));
+    fields.emplace_back("p50", to_string(h.getPercentile(50)));
+    fields.emplace_back("p90", to_string(h.getPercentile(90)));
+    fields.emplace_back("p99", to_string(h.getPercentile(99)));
+    return fields;
+}
+
+void MetricsRegistry::exportTo(Table &table)
+{
+    lock_guard<mutex> lock(m_mutex);
+
+    for (const auto &it: m_counters)
+    {
+        table.set(it.first, { { "value", to_string(it.second->get()) } });
+    }
+
+    for (const auto &it: m_gauges)
+    {
+        table.set(it.first, { { "value", to_string(it.second->get()) } });
+    }
+
+    for (const auto &it: m_histograms)
+    {
+        table.set(it.first, histogramFields(*it.second));
+    }
+
+    table.flush();
+}
+
+string MetricsRegistry::dump()
+{
+    lock_guard<mutex> lock(m_mutex);
+    ostringstream out;
+
+    for (const auto &it: m_counters)
+    {
+        out << it.first << " value " << it.second->get() << "\n";
+    }
+
+    for (const auto &it: m_gauges)
+    {
+        out << it.first << " value " << it.second->get() << "\n";
+    }
+
+    for (const auto &it: m_histograms)
+    {
+        for (const auto &fv: histogramFields(*it.second))
+        {
+            out << it.first << " " << fvField(fv) << " " << fvValue(fv) << "\n";
+        }
+    }
+
+    return out.str();
+}
+
+void MetricsRegistry::reset()
+{
+    lock_guard<mutex> lock(m_mutex);
+
+    for (const auto &it: m_counters)
+    {
+        it.second->reset();
+    }
+
+    for (const auto &it: m_gauges)
+    {
+        it.second->set(0);
+    }
+
+    for (const auto &it: m_histograms)
+    {
+        it.second->reset();
+    }
+}
+
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <stdint.h>
+#include "histogram.h"
+
+namespace swss {
+
+class Table;
+
+class Counter
+{
+public:
+    Counter() : m_value(0) {}
+
+    void inc(uint64_t n = 1)
+    {
+        m_value.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    uint64_t get() const
+    {
+        return m_value.load(std::memory_order_relaxed);
+    }
+
+    void reset()
+    {
+        m_value.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<uint64_t> m_value;
+};
+
+class Gauge
+{
+public:
+    Gauge() : m_value(0) {}
+
+    void set(int64_t value)
+    {
+        m_value.store(value, std::memory_order_relaxed);
+    }
+
+    void add(int64_t n)
+    {
+        m_value.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    int64_t get() const
+    {
+        return m_value.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<int64_t> m_value;
+};
+
+/*
+ * Process wide registry of named metrics
+ *
+ * Looking a metric up takes a lock, objects keep the returned reference
+ * and update it lock-free. Metrics live as long as the process, objects
+ * with the same name share them.
+ */
+class MetricsRegistry
+{
+public:
+    static MetricsRegistry &getInstance();
+
+    Counter &getCounter(const std::string &name);
+    Gauge &getGauge(const std::string &name);
+    Histogram &getHistogram(const std::string &name);
+
+    /* Write one entry per metric, keyed by its name, e.g. to a
+     * STATE_DB or COUNTERS_DB table */
+    void exportTo(Table &table);
+
+    /* One "name field value" line per value, as served by MetricsServer */
+    std::string dump();
+
+    /* Zero every metric */
+    void reset();
+
+private:
+    MetricsRegistry() = default;
+
+    std::mutex m_mutex;
+    std::map<std::string, std::unique_ptr<Counter>> m_counters;
+    std::map<std::string, std::unique_ptr<Gauge>> m_gauges;
+    std::map<std::string, std::unique_ptr<Histogram>> m_histograms;
+};
+
+}
@@ -0,0 +1,273 @@
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <system_error>
+#include "logger.h"
+#include "metrics.h"
+#include "metricsserver.h"
+
+namespace swss {
+
+const size_t MetricsServer::MAX_CLIENTS;
+const int MetricsServer::CLIENT_TIMEOUT_MS;
+
+MetricsServer::MetricsServer(const std::string &path, int pri)
+    : Selectable(pri)
+    , m_path(path)
+{
+    struct sockaddr_un addr;
+
+    if (path.size() >= sizeof(addr.sun_path))
+    {
+        throw std::invalid_argument("Metrics socket path too long");
+    }
+
+    m_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (m_fd == -1)
+    {
+        throw std::system_error(errno, std::system_category(), "Unable to create metrics socket");
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+    /* Left over by a previous instance */
+    unlink(path.c_str());
+
+    if (bind(m_fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) == -1 ||
+        listen(m_fd, 8) == -1)
+    {
+        int err = errno;
+        close(m_fd);
+        throw std::system_error(err, std::system_category(), "Unable to listen on " + path);
+    }
+
+    m_epollFd = epoll_create1(EPOLL_CLOEXEC);
+    m_timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.fd = m_fd;
+
+    struct epoll_event tev;
+    memset(&tev, 0, sizeof(tev));
+    tev.events = EPOLLIN;
+    tev.data.fd = m_timerFd;
+
+    if (m_epollFd == -1 || m_timerFd == -1 ||
+        epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_fd, &ev) == -1 ||
+        epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_timerFd, &tev) == -1)
+    {
+        int err = errno;
+        if (m_epollFd != -1)
+        {
+            close(m_epollFd);
+        }
+        if (m_timerFd != -1)
+        {
+            close(m_timerFd);
+        }
+        close(m_fd);
+        unlink(path.c_str());
+        throw std::system_error(err, std::system_category(), "Unable to poll metrics socket");
+    }
+}
+
+MetricsServer::~MetricsServer()
+{
+    for (const auto &it: m_clients)
+    {
+        close(it.first);
+    }
+
+    close(m_timerFd);
+    close(m_epollFd);
+    close(m_fd);
+    unlink(m_path.c_str());
+}
+
+int MetricsServer::getFd()
+{
+    return m_epollFd;
+}
+
+void MetricsServer::readData()
+{
+    /* First, so that new connections can take their place */
+    auto now = std::chrono::steady_clock::now();
+    std::vector<int> stale;
+
+    for (const auto &it: m_clients)
+    {
+        if (now - it.second.lastSent >= std::chrono::milliseconds(CLIENT_TIMEOUT_MS))
+        {
+            stale.push_back(it.first);
+        }
+    }
+
+    for (int fd: stale)
+    {
+        SWSS_LOG_WARN("Dropping metrics connection not reading for %d ms", CLIENT_TIMEOUT_MS);
+        dropClient(fd);
+    }
+
+    struct epoll_event events[MAX_CLIENTS + 1];
+
+    int count = epoll_wait(m_epollFd, events, static_cast<int>(MAX_CLIENTS + 1), 0);
+    if (count == -1 && errno != EINTR)
+    {
+        SWSS_LOG_WARN("Failed to poll metrics sockets: %s", strerror(errno));
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        int fd = events[i].data.fd;
+
+        if (fd == m_fd)
+        {
+            acceptClients();
+            continue;
+        }
+
+        /* Stale connections were dropped above */
+        if (fd == m_timerFd)
+        {
+            uint64_t expirations;
+            if (read(m_timerFd, &expirations, sizeof(expirations)) == -1 && errno != EAGAIN)
+            {
+                SWSS_LOG_WARN("Failed to read metrics timer: %s", strerror(errno));
+            }
+            continue;
+        }
+
+        auto it = m_clients.find(fd);
+        if (it != m_clients.end() && !sendClient(fd, it->second))
+        {
+            dropClient(fd);
+        }
+    }
+
+    armTimer();
+}
+
+void MetricsServer::armTimer()
+{
+    struct itimerspec its;
+    memset(&its, 0, sizeof(its));
+
+    if (!m_clients.empty())
+    {
+        auto oldest = std::chrono::steady_clock::time_point::max();
+        for (const auto &it: m_clients)
+        {
+            oldest = std::min(oldest, it.second.lastSent);
+        }
+
+        auto left = std::chrono::duration_cast<std::chrono::microseconds>(
+                oldest + std::chrono::milliseconds(CLIENT_TIMEOUT_MS) - std::chrono::steady_clock::now());
+
+        /* An all zero value disarms the timer, fire right away instead */
+        int64_t us = std::max<int64_t>(left.count(), 1);
+        its.it_value.tv_sec = static_cast<time_t>(us / 1000000);
+        its.it_value.tv_nsec = static_cast<long>((us % 1000000) * 1000);
+    }
+
+    if (timerfd_settime(m_timerFd, 0, &its, NULL) == -1)
+    {
+        SWSS_LOG_WARN("Failed to arm metrics timer: %s", strerror(errno));
+    }
+}
+
+void MetricsServer::acceptClients()
+{
+    for (;;)
+    {
+        int fd = accept4(m_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd == -1)
+        {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+            {
+                SWSS_LOG_WARN("Failed to accept metrics connection: %s", strerror(errno));
+            }
+            return;
+        }
+
+        if (m_clients.size() >= MAX_CLIENTS)
+        {
+            SWSS_LOG_WARN("Closing metrics connection, %zu are still being served", m_clients.size());
+            close(fd);
+            continue;
+        }
+
+        Client client;
+        client.data = MetricsRegistry::getInstance().dump();
+        client.sent = 0;
+        client.lastSent = std::chrono::steady_clock::now();
+
+        /* Most dumps fit in the socket buffer and are done with here */
+        if (!sendClient(fd, client))
+        {
+            close(fd);
+            continue;
+        }
+
+        struct epoll_event ev;
+        memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLOUT;
+        ev.data.fd = fd;
+
+        if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, fd, &ev) == -1)
+        {
+            SWSS_LOG_WARN("Failed to poll metrics connection: %s", strerror(errno));
+            close(fd);
+            continue;
+        }
+
+        m_clients[fd] = std::move(client);
+    }
+}
+
+bool MetricsServer::sendClient(int fd, Client &client)
+{
+    while (client.sent < client.data.size())
+    {
+        ssize_t n = send(fd, client.data.data() + client.sent, client.data.size() - client.sent,
+                         MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (n == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                return true;
+            }
+            SWSS_LOG_WARN("Failed to send metrics: %s", strerror(errno));
+            return false;
+        }
+
+        client.sent += static_cast<size_t>(n);
+        client.lastSent = std::chrono::steady_clock::now();
+    }
+
+    return false;
+}
+
+void MetricsServer::dropClient(int fd)
+{
+    epoll_ctl(m_epollFd, EPOLL_CTL_DEL, fd, NULL);
+    close(fd);
+    m_clients.erase(fd);
+}
+
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <string>
+#include "selectable.h"
+
+namespace swss {
+
+/*
+ * Serve MetricsRegistry::dump() on a unix stream socket, each connection
+ * gets the current metrics and is closed. Add it to the Select loop of the
+ * process, nothing is needed when it is returned.
+ *
+ * Metrics are sent without blocking: getFd() is an epoll set of the
+ * listening socket and of the connections not fully written yet, so the
+ * loop comes back when they can take more. Each connection holds one dump
+ * at most. Connections beyond MAX_CLIENTS are closed right away, and those
+ * not reading for CLIENT_TIMEOUT_MS are dropped, a timer in the epoll set
+ * brings the loop back for that even when nothing else happens.
+ */
+class MetricsServer : public Selectable
+{
+public:
+    static const size_t MAX_CLIENTS = 16;
+    static const int CLIENT_TIMEOUT_MS = 1000;
+
+    MetricsServer(const std::string &path, int pri = 0);
+    virtual ~MetricsServer();
+
+    int getFd() override;
+    void readData() override;
+
+private:
+    struct Client
+    {
+        std::string data;
+        size_t sent;
+        std::chrono::steady_clock::time_point lastSent;
+    };
+
+    void acceptClients();
+    /* Returns true while metrics are left to send, false once all sent or on error */
+    bool sendClient(int fd, Client &client);
+    void dropClient(int fd);
+    /* Fire when the oldest connection times out, disarmed without any */
+    void armTimer();
+
+    std::string m_path;
+    int m_fd;
+    int m_epollFd;
+    int m_timerFd;
+    std::map<int, Client> m_clients;
+};
+
+}
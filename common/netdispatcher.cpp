@@ -1,15 +1,32 @@
+#include <algorithm>
 #include <map>
 #include "common/netdispatcher.h"
 #include "common/netmsg.h"
 
 using namespace swss;
 
-NetDispatcher::NetDispatcher()
+const size_t NetDispatcher::DEFAULT_MAX_BATCH_SIZE;
+const size_t NetDispatcher::NO_PENDING;
+
+NetDispatcher::NetDispatcher() :
+    m_pendingCount(0),
+    m_maxBatchSize(DEFAULT_MAX_BATCH_SIZE),
+    m_trackState(false),
+    m_generation(0),
+    m_callback(NULL),
+    m_source(NULL)
 {
 }
 
 NetDispatcher::~NetDispatcher()
 {
+    for (auto &p : m_pending)
+    {
+        if (p.obj)
+            nl_object_put(p.obj);
+    }
+
+    setStateTracking(false);
 }
 
 NetDispatcher& NetDispatcher::getInstance()
@@ -20,26 +37,321 @@ NetDispatcher& NetDispatcher::getInstance()
 
 void NetDispatcher::registerMessageHandler(int nlmsg_type, NetMsg *callback)
 {
-    if (m_handlers.find(nlmsg_type) != m_handlers.end())
+    if (m_handlers.find(nlmsg_type) != m_handlers.end() ||
+        m_batchHandlers.find(nlmsg_type) != m_batchHandlers.end())
         throw "Trying to registered on already registerd netlink message";
 
     m_handlers[nlmsg_type] = callback;
 }
 
+void NetDispatcher::registerBatchHandler(int nlmsg_type, NetBatchMsg *callback)
+{
+    if (m_handlers.find(nlmsg_type) != m_handlers.end() ||
+        m_batchHandlers.find(nlmsg_type) != m_batchHandlers.end())
+        throw "Trying to registered on already registerd netlink message";
+
+    m_batchHandlers[nlmsg_type] = callback;
+}
+
+void NetDispatcher::unregisterMessageHandler(int nlmsg_type)
+{
+    m_handlers.erase(nlmsg_type);
+    m_batchHandlers.erase(nlmsg_type);
+}
+
+void NetDispatcher::setMaxBatchSize(size_t size)
+{
+    m_maxBatchSize = std::max(size, (size_t)1);
+}
+
+/* rtnetlink message types come in NEW, DEL, GET, SET order from RTM_BASE */
+static inline bool isNewType(int type)
+{
+    return type >= RTM_BASE && (type - RTM_BASE) % 4 == 0;
+}
+
+/* RTM_DEL* of an RTM_NEW* type and conversely, -1 for other types */
+static inline int counterpartType(int type)
+{
+    if (isNewType(type))
+        return type + 1;
+    if (isNewType(type - 1))
+        return type - 1;
+    return -1;
+}
+
+bool NetDispatcher::isCounterpartPending(int type) const
+{
+    return m_pendingCount > 0 &&
+           m_batchHandlers.find(counterpartType(type)) != m_batchHandlers.end();
+}
+
 void NetDispatcher::nlCallback(struct nl_object *obj, void *context)
 {
-    NetMsg *callback = (NetMsg *)context;
-    callback->onMsg(nl_object_get_msgtype(obj), obj);
+    NetDispatcher *dispatcher = (NetDispatcher *)context;
+
+    if (dispatcher->updateState(obj))
+        dispatcher->m_callback->onMsg(nl_object_get_msgtype(obj), obj);
 }
 
-void NetDispatcher::onNetlinkMessage(struct nl_msg *msg)
+void NetDispatcher::nlBatchCallback(struct nl_object *obj, void *context)
+{
+    NetDispatcher *dispatcher = (NetDispatcher *)context;
+
+    if (dispatcher->updateState(obj))
+        dispatcher->addPending(obj, nl_object_get_msgtype(obj));
+}
+
+void NetDispatcher::addPending(struct nl_object *obj, int type)
+{
+    uint32_t hash;
+    nl_object_keygen(obj, &hash, UINT32_MAX);
+
+    size_t *last = m_pendingIndex.find(hash);
+    size_t next = last ? *last : NO_PENDING;
+
+    /* A newer update of the same object replaces the pending one */
+    for (size_t i = next; i != NO_PENDING; i = m_pending[i].next)
+    {
+        Pending &p = m_pending[i];
+        if (p.obj && nl_object_identical(p.obj, obj))
+        {
+            nl_object_put(p.obj);
+            p.obj = NULL;
+            m_pendingCount--;
+            break;
+        }
+    }
+
+    nl_object_get(obj);
+    m_pending.push_back({ type, obj, next });
+    m_pendingIndex[hash] = m_pending.size() - 1;
+    m_pendingCount++;
+}
+
+void NetDispatcher::onNetlinkMessage(struct nl_msg *msg, const void *source)
 {
     struct nlmsghdr *nlmsghdr = nlmsg_hdr(msg);
+
+    m_source = source;
+
+    if (m_batchHandlers.find(nlmsghdr->nlmsg_type) != m_batchHandlers.end())
+    {
+        nl_msg_parse(msg, NetDispatcher::nlBatchCallback, (void *)this);
+
+        if (m_pendingCount >= m_maxBatchSize)
+            flush();
+        return;
+    }
+
     auto callback = m_handlers.find(nlmsghdr->nlmsg_type);
 
     /* Drop not registered messages */
     if (callback == m_handlers.end())
         return;
 
-    nl_msg_parse(msg, NetDispatcher::nlCallback, (void *)(callback->second));
+    /* A pending update of the same object must not be delivered after this one */
+    if (isCounterpartPending(nlmsghdr->nlmsg_type))
+        flush();
+
+    m_callback = callback->second;
+    nl_msg_parse(msg, NetDispatcher::nlCallback, (void *)this);
+}
+
+void NetDispatcher::flush()
+{
+    if (m_pending.empty())
+        return;
+
+    /* Handlers may receive more messages while we iterate */
+    std::vector<Pending> pending;
+    pending.swap(m_pending);
+    m_pendingIndex.clear();
+    m_pendingCount = 0;
+
+    pending.erase(std::remove_if(pending.begin(), pending.end(),
+                                 [](const Pending &p) { return p.obj == NULL; }),
+                  pending.end());
+
+    /* Each object is pending once, so grouping by type does not reorder updates of one object */
+    std::stable_sort(pending.begin(), pending.end(),
+                     [](const Pending &a, const Pending &b) { return a.type < b.type; });
+
+    std::vector<struct nl_object *> batch;
+
+    try
+    {
+        for (auto it = pending.begin(); it != pending.end(); )
+        {
+            int type = it->type;
+
+            batch.clear();
+            for (; it != pending.end() && it->type == type; ++it)
+                batch.push_back(it->obj);
+
+            auto callback = m_batchHandlers.find(type);
+            if (callback != m_batchHandlers.end())
+                callback->second->onMsgBatch(type, batch);
+        }
+    }
+    catch (...)
+    {
+        for (auto &p : pending)
+            nl_object_put(p.obj);
+        throw;
+    }
+
+    for (auto &p : pending)
+        nl_object_put(p.obj);
+}
+
+void NetDispatcher::setStateTracking(bool enable)
+{
+    m_trackState = enable;
+
+    if (!enable)
+    {
+        for (auto &s : m_state)
+            nl_object_put(s.second.obj);
+        m_state.clear();
+    }
+}
+
+bool NetDispatcher::updateState(struct nl_object *obj)
+{
+    int type = nl_object_get_msgtype(obj);
+
+    if (!m_trackState || !(isNewType(type) || isNewType(type - 1)))
+        return true;
+
+    uint32_t hash;
+    nl_object_keygen(obj, &hash, UINT32_MAX);
+
+    auto range = m_state.equal_range(hash);
+    auto it = range.first;
+    while (it != range.second &&
+           (it->second.source != m_source || !nl_object_identical(it->second.obj, obj)))
+        ++it;
+
+    if (!isNewType(type))
+    {
+        if (it != range.second)
+        {
+            nl_object_put(it->second.obj);
+            m_state.erase(it);
+        }
+        return true;
+    }
+
+    const Resync *resync = resyncOf(obj);
+    uint64_t generation = resync ? resync->generation : 0;
+
+    nl_object_get(obj);
+
+    if (it == range.second)
+    {
+        m_state.emplace(hash, State{ obj, m_source, generation });
+        return true;
+    }
+
+    bool unchanged = nl_object_diff(it->second.obj, obj) == 0;
+
+    nl_object_put(it->second.obj);
+    it->second.obj = obj;
+    if (resync)
+        it->second.generation = generation;
+
+    return !(resync && unchanged);
+}
+
+const NetDispatcher::Resync *NetDispatcher::resyncOf(struct nl_object *obj) const
+{
+    auto resync = m_resyncs.find(m_source);
+    if (resync == m_resyncs.end())
+        return NULL;
+
+    const std::vector<int> &types = resync->second.types;
+    if (std::find(types.begin(), types.end(), nl_object_get_msgtype(obj)) == types.end())
+        return NULL;
+
+    return &resync->second;
+}
+
+void NetDispatcher::beginResync(const void *source, const std::vector<int> &rtmGetCommands)
+{
+    Resync &resync = m_resyncs[source];
+
+    /* Each RTM_GET* dump returns the RTM_NEW* type two below it */
+    resync.types.clear();
+    for (int command : rtmGetCommands)
+        resync.types.push_back(command - 2);
+
+    resync.generation = ++m_generation;
+}
+
+void NetDispatcher::endResync(const void *source)
+{
+    auto current = m_resyncs.find(source);
+    if (current == m_resyncs.end())
+        return;
+
+    Resync resync = current->second;
+    m_resyncs.erase(current);
+
+    /* Updates from the dumps go first */
+    flush();
+
+    std::vector<struct nl_object *> deleted;
+    for (auto it = m_state.begin(); it != m_state.end(); )
+    {
+        const State &state = it->second;
+
+        if (state.source == source && state.generation != resync.generation &&
+            std::find(resync.types.begin(), resync.types.end(),
+                      nl_object_get_msgtype(state.obj)) != resync.types.end())
+        {
+            deleted.push_back(it->second.obj);
+            it = m_state.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    for (size_t i = 0; i < deleted.size(); i++)
+    {
+        try
+        {
+            dispatch(deleted[i], nl_object_get_msgtype(deleted[i]) + 1);
+        }
+        catch (...)
+        {
+            for (; i < deleted.size(); i++)
+                nl_object_put(deleted[i]);
+            throw;
+        }
+
+        nl_object_put(deleted[i]);
+    }
+
+    flush();
+}
+
+void NetDispatcher::dispatch(struct nl_object *obj, int type)
+{
+    if (m_batchHandlers.find(type) != m_batchHandlers.end())
+    {
+        addPending(obj, type);
+        return;
+    }
+
+    auto callback = m_handlers.find(type);
+    if (callback == m_handlers.end())
+        return;
+
+    if (isCounterpartPending(type))
+        flush();
+
+    callback->second->onMsg(type, obj);
 }
@@ -8,13 +8,18 @@
 #include <netlink/route/rtnl.h>
 
 #include <map>
+#include <unordered_map>
+#include <vector>
 
 #include "netmsg.h"
+#include "flathashmap.h"
 
 namespace swss {
 
 class NetDispatcher {
 public:
+    static const size_t DEFAULT_MAX_BATCH_SIZE = 1024;
+
     /**/
     static NetDispatcher& getInstance();
 
@@ -26,9 +31,59 @@ public:
     void registerMessageHandler(int nlmsg_type, NetMsg *callback);
 
     /*
-     * Called by NetLink or FpmLink classes as indication of new packet arrival
+     * Register a callback receiving the messages of nlmsg_type in batches,
+     * see NetBatchMsg. Throws like registerMessageHandler().
+     *
+     * When the RTM_NEW* and RTM_DEL* types of objects have handlers of both
+     * kinds, pending batches are flushed before a message of the per-message
+     * type is delivered, so updates of an object stay in order.
+     */
+    void registerBatchHandler(int nlmsg_type, NetBatchMsg *callback);
+
+    /* Remove the handler of either kind registered for nlmsg_type */
+    void unregisterMessageHandler(int nlmsg_type);
+
+    /*
+     * Called by NetLink or FpmLink classes as indication of new packet arrival.
+     * source identifies the caller for state tracking, see beginResync().
+     */
+    void onNetlinkMessage(struct nl_msg *msg, const void *source = NULL);
+
+    /*
+     * Hand the pending batches to their handlers. Called by NetLink once
+     * its socket is drained, and whenever maxBatchSize objects are pending.
      */
-    void onNetlinkMessage(struct nl_msg *msg);
+    void flush();
+
+    void setMaxBatchSize(size_t size);
+
+    /*
+     * Keep the last object of every RTM_NEW* message dispatched, holding a
+     * reference to one libnl object per link, route, etc., so that a
+     * resync only passes what changed. Off by default.
+     */
+    void setStateTracking(bool enable);
+
+    /*
+     * Called by NetLink before dumping the kernel state again after losing
+     * messages, with the RTM_GET* commands it dumps. Until endResync(),
+     * objects of source returned by these dumps are not dispatched when
+     * equal to their known state.
+     */
+    void beginResync(const void *source, const std::vector<int> &rtmGetCommands);
+
+    /*
+     * Called once the dumps are complete. Known objects of source and of the
+     * dumped types the dumps did not return are dispatched with the matching
+     * RTM_DEL* type, then forgotten. Other sources and types are left as is.
+     */
+    void endResync(const void *source);
+
+    /* Whether any source is resynchronising */
+    bool isResyncing() const
+    {
+        return !m_resyncs.empty();
+    }
 
 private:
     NetDispatcher();
@@ -36,8 +91,67 @@ private:
 
     /* nl_msg_parse callback API */
     static void nlCallback(struct nl_object *obj, void *context);
+    static void nlBatchCallback(struct nl_object *obj, void *context);
+
+    void addPending(struct nl_object *obj, int type);
+
+    /* Returns false when obj is not to be dispatched */
+    bool updateState(struct nl_object *obj);
+
+    void dispatch(struct nl_object *obj, int type);
+
+    /*
+     * Whether objects are pending for the batch handler of the RTM_NEW* or
+     * RTM_DEL* counterpart of type, and must be flushed before dispatching it
+     */
+    bool isCounterpartPending(int type) const;
+
+    static const size_t NO_PENDING = SIZE_MAX;
+
+    struct Pending
+    {
+        int type;
+        struct nl_object *obj;
+        /* Previous pending object with the same hash */
+        size_t next;
+    };
 
     std::map<int, NetMsg * > m_handlers;
+    std::map<int, NetBatchMsg * > m_batchHandlers;
+
+    /* Objects waiting for flush(), coalesced ones are left as NULL */
+    std::vector<Pending> m_pending;
+    /* nl_object_keygen() hash to the last index in m_pending with that hash */
+    FlatHashMap<uint32_t, size_t> m_pendingIndex;
+    size_t m_pendingCount;
+    size_t m_maxBatchSize;
+
+    struct State
+    {
+        struct nl_object *obj;
+        const void *source;
+        /* Last resync that saw the object */
+        uint64_t generation;
+    };
+
+    struct Resync
+    {
+        /* RTM_NEW* types returned by the dumps */
+        std::vector<int> types;
+        uint64_t generation;
+    };
+
+    /* Resync of m_source covering the type of obj, NULL if none */
+    const Resync *resyncOf(struct nl_object *obj) const;
+
+    bool m_trackState;
+    std::map<const void *, Resync> m_resyncs;
+    uint64_t m_generation;
+    /* Last RTM_NEW* object by nl_object_keygen() hash */
+    std::unordered_multimap<uint32_t, State> m_state;
+    /* Handler and source nl_msg_parse() is currently called for */
+    NetMsg *m_callback;
+    const void *m_source;
 };
 
 }
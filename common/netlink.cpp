@@ -1,4 +1,5 @@
 #include <string.h>
+#include <algorithm>
 #include <errno.h>
 #include <system_error>
 #include "common/logger.h"
@@ -10,7 +11,14 @@ using namespace swss;
 using namespace std;
 
 NetLink::NetLink(int pri) :
-    Selectable(pri), m_socket(NULL)
+    Selectable(pri), m_socket(NULL),
+    m_resyncing(false),
+    m_resyncIndex(0),
+    m_resyncSeq(0),
+    m_resyncRetry(false),
+    m_overruns(MetricsRegistry::getInstance().getCounter("netlink.overruns")),
+    m_resyncs(MetricsRegistry::getInstance().getCounter("netlink.resyncs")),
+    m_resyncTime(MetricsRegistry::getInstance().getHistogram("netlink.resync_us"))
 {
     m_socket = nl_socket_alloc();
     if (!m_socket)
@@ -22,6 +30,7 @@ NetLink::NetLink(int pri) :
 
     nl_socket_disable_seq_check(m_socket);
     nl_socket_modify_cb(m_socket, NL_CB_VALID, NL_CB_CUSTOM, onNetlinkMsg, this);
+    nl_socket_modify_cb(m_socket, NL_CB_FINISH, NL_CB_CUSTOM, onNetlinkFinish, this);
 
     int err = nl_connect(m_socket, NETLINK_ROUTE);
     if (err < 0)
@@ -61,7 +70,8 @@ void NetLink::registerGroup(int rtnlGroup)
 
 void NetLink::dumpRequest(int rtmGetCommand)
 {
-    int err = nl_rtgen_request(m_socket, rtmGetCommand, AF_UNSPEC, NLM_F_DUMP);
+    uint32_t seq;
+    int err = sendDump(rtmGetCommand, seq);
     if (err < 0)
     {
         SWSS_LOG_ERROR("Unable to request dump on group %d: %s", rtmGetCommand,
@@ -69,6 +79,91 @@ void NetLink::dumpRequest(int rtmGetCommand)
         throw system_error(make_error_code(errc::address_not_available),
                            "Unable to request dump");
     }
+
+    if (find(m_dumps.begin(), m_dumps.end(), rtmGetCommand) == m_dumps.end())
+        m_dumps.push_back(rtmGetCommand);
+}
+
+/* nl_rtgen_request() with a known sequence number */
+int NetLink::sendDump(int rtmGetCommand, uint32_t &seq)
+{
+    struct rtgenmsg gen;
+    memset(&gen, 0, sizeof(gen));
+    gen.rtgen_family = AF_UNSPEC;
+
+    struct nl_msg *msg = nlmsg_alloc_simple(rtmGetCommand, NLM_F_DUMP);
+    if (!msg)
+        return -NLE_NOMEM;
+
+    int err = nlmsg_append(msg, &gen, sizeof(gen), NLMSG_ALIGNTO);
+    if (err >= 0)
+    {
+        seq = nl_socket_use_seq(m_socket);
+        nlmsg_hdr(msg)->nlmsg_seq = seq;
+        err = nl_send_auto(m_socket, msg);
+    }
+
+    nlmsg_free(msg);
+    return err;
+}
+
+void NetLink::resync()
+{
+    if (m_dumps.empty())
+        return;
+
+    if (!m_resyncing)
+    {
+        m_resyncStart = chrono::steady_clock::now();
+        m_resyncs.inc();
+    }
+
+    SWSS_LOG_NOTICE("Resynchronising netlink state");
+
+    m_resyncing = true;
+    m_resyncIndex = 0;
+    NetDispatcher::getInstance().beginResync(this, m_dumps);
+    sendResyncDump();
+}
+
+void NetLink::sendResyncDump()
+{
+    int err = sendDump(m_dumps[m_resyncIndex], m_resyncSeq);
+
+    /* Tried again once the dump in the way completes */
+    m_resyncRetry = err < 0;
+    if (err < 0)
+        SWSS_LOG_WARN("Unable to request resync dump %d: %s", m_dumps[m_resyncIndex], nl_geterror(err));
+}
+
+void NetLink::onDumpDone(uint32_t seq)
+{
+    if (!m_resyncing)
+        return;
+
+    if (m_resyncRetry)
+    {
+        sendResyncDump();
+        return;
+    }
+
+    if (seq != m_resyncSeq)
+        return;
+
+    if (++m_resyncIndex < m_dumps.size())
+    {
+        sendResyncDump();
+        return;
+    }
+
+    m_resyncing = false;
+    NetDispatcher::getInstance().endResync(this);
+
+    auto elapsed = chrono::steady_clock::now() - m_resyncStart;
+    auto us = chrono::duration_cast<chrono::microseconds>(elapsed).count();
+    m_resyncTime.record(static_cast<uint64_t>(us));
+
+    SWSS_LOG_NOTICE("Resynchronised netlink state in %ld us", static_cast<long>(us));
 }
 
 int NetLink::getFd()
@@ -78,27 +173,75 @@ int NetLink::getFd()
 
 void NetLink::readData()
 {
+    struct nl_cb *cb = nl_socket_get_cb(m_socket);
     int err;
+    int reads = 0;
 
+    /*
+     * Drain what the socket holds so that batch handlers see a whole burst
+     * at once, but leave the rest to the next select() in a storm
+     */
     do
     {
-        err = nl_recvmsgs_default(m_socket);
+        err = nl_recvmsgs_report(m_socket, cb);
     }
-    while(err == -NLE_INTR); // Retry if the process was interrupted by a signal
+    while ((err > 0 && ++reads < MAX_READS_PER_EVENT) ||
+           err == -NLE_INTR); // Retry if the process was interrupted by a signal
+
+    nl_cb_put(cb);
 
     if (err < 0)
     {
+        /* libnl reports ENOBUFS, the socket buffer overrun, as out of memory */
         if (err == -NLE_NOMEM)
+        {
             SWSS_LOG_ERROR("netlink reports out of memory on reading a netlink socket. High possiblity of a lost message");
+            m_overruns.inc();
+            onOverrun();
+        }
+        else if (err == -NLE_BUSY && m_resyncing)
+        {
+            m_resyncRetry = true;
+        }
         else if (err == -NLE_AGAIN)
             SWSS_LOG_DEBUG("netlink reports NLE_AGAIN on reading a netlink socket");
         else
             SWSS_LOG_ERROR("netlink reports an error=%d on reading a netlink socket", err);
     }
+
+    flush();
+}
+
+void NetLink::onMessage(struct nl_msg *msg)
+{
+    NetDispatcher::getInstance().onNetlinkMessage(msg, this);
+}
+
+void NetLink::onOverrun()
+{
+    resync();
+}
+
+void NetLink::flush()
+{
+    NetDispatcher::getInstance().flush();
 }
 
 int NetLink::onNetlinkMsg(struct nl_msg *msg, void *arg)
 {
-    NetDispatcher::getInstance().onNetlinkMessage(msg);
+    NetLink *netlink = (NetLink *)arg;
+    netlink->onMessage(msg);
     return NL_OK;
 }
+
+int NetLink::onNetlinkFinish(struct nl_msg *msg, void *arg)
+{
+    NetLink *netlink = (NetLink *)arg;
+
+    /* Updates received during the dump are handed over before it ends */
+    netlink->flush();
+    netlink->onDumpDone(nlmsg_hdr(msg)->nlmsg_seq);
+
+    /* What libnl does by default */
+    return NL_STOP;
+}
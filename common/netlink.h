@@ -1,12 +1,23 @@
 #ifndef __NETLINK__
 #define __NETLINK__
 
+#include <chrono>
+#include <vector>
 #include <linux/netlink.h>
 #include <linux/rtnetlink.h>
 #include "selectable.h"
+#include "metrics.h"
 
 namespace swss {
 
+/*
+ * When the socket overruns and messages are lost, NetLink dumps again,
+ * one after the other, what was requested through dumpRequest(). With
+ * NetDispatcher state tracking on, only what changed meanwhile is then
+ * dispatched, including deletions of objects this NetLink received of the
+ * dumped types. Overruns and resyncs are counted in
+ * the netlink.overruns, netlink.resyncs and netlink.resync_us metrics.
+ */
 class NetLink : public Selectable {
 public:
     NetLink(int pri = 0);
@@ -18,10 +29,53 @@ public:
     int getFd() override;
     void readData() override;
 
+    bool isResyncing() const
+    {
+        return m_resyncing;
+    }
+
+    /* Dump everything requested so far again */
+    void resync();
+
+protected:
+    /* Hands a received message to NetDispatcher */
+    virtual void onMessage(struct nl_msg *msg);
+
+    /* Messages were lost, resync() by default */
+    virtual void onOverrun();
+
+    /*
+     * Called once the socket is drained and before a dump completes, hands
+     * the pending batches to their handlers by default
+     */
+    virtual void flush();
+
 private:
+    /* Receive calls per readData(), each reads one datagram of messages */
+    static const int MAX_READS_PER_EVENT = 64;
+
     static int onNetlinkMsg(struct nl_msg *msg, void *arg);
+    static int onNetlinkFinish(struct nl_msg *msg, void *arg);
+
+    /* Returns a libnl error code, the request sequence number in seq */
+    int sendDump(int rtmGetCommand, uint32_t &seq);
+    void sendResyncDump();
+    void onDumpDone(uint32_t seq);
 
     nl_sock *m_socket;
+
+    std::vector<int> m_dumps;
+    bool m_resyncing;
+    /* Index in m_dumps of the dump in progress and its sequence number */
+    size_t m_resyncIndex;
+    uint32_t m_resyncSeq;
+    /* The kernel refused the dump while another one was running */
+    bool m_resyncRetry;
+    std::chrono::steady_clock::time_point m_resyncStart;
+
+    Counter &m_overruns;
+    Counter &m_resyncs;
+    Histogram &m_resyncTime;
 };
 
 }
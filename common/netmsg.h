@@ -7,6 +7,8 @@
 #include <netlink/data.h>
 #include <netlink/route/rtnl.h>
 
+#include <vector>
+
 namespace swss {
 
 class NetMsg {
@@ -15,6 +17,17 @@ public:
     virtual void onMsg(int nlmsg_type, struct nl_object *obj) = 0;
 };
 
+class NetBatchMsg {
+public:
+    /*
+     * Called by NetDispatcher with the objects of nlmsg_type received since
+     * the previous batch, in arrival order. An object updated several times
+     * in between is only passed once, with its last message type. The
+     * objects are released when this returns.
+     */
+    virtual void onMsgBatch(int nlmsg_type, const std::vector<struct nl_object *> &objs) = 0;
+};
+
 }
 
 #endif
@@ -1,4 +1,5 @@
 #include "notificationconsumer.h"
+#include "json.hpp"
 
 #include <iostream>
 
@@ -10,7 +11,14 @@ swss::NotificationConsumer::NotificationConsumer(swss::DBConnector *db, const st
     Selectable(pri),
     m_db(db),
     m_subscribe(NULL),
-    m_channel(channel)
+    m_channel(channel),
+    m_queueLimit(0),
+    m_queuePolicy(DROP),
+    m_dropped(0),
+    m_coalesced(0),
+    m_frontSeq(0),
+    m_queueMetric(MetricsRegistry::getInstance().getGauge("notification." + channel + ".queue")),
+    m_droppedMetric(MetricsRegistry::getInstance().getCounter("notification." + channel + ".dropped"))
 {
     SWSS_LOG_ENTER();
 
@@ -32,6 +40,7 @@ swss::NotificationConsumer::NotificationConsumer(swss::DBConnector *db, const st
 
 swss::NotificationConsumer::~NotificationConsumer()
 {
+    m_queueMetric.add(-static_cast<int64_t>(m_queue.size()));
     delete m_subscribe;
 }
 
@@ -129,7 +138,115 @@ void swss::NotificationConsumer::processReply(redisReply *reply)
 
     SWSS_LOG_DEBUG("got message: %s", msg.c_str());
 
-    m_queue.push(msg);
+    nlohmann::json j = nlohmann::json::parse(msg);
+
+    /*
+     * Packed message from a NotificationProducer with pack size set, it is
+     * an array of regular notifications, see NotificationProducer::publishPacked
+     */
+    bool packed = msg.compare(0, 2, "[[") == 0;
+
+    for (size_t n = 0; n < (packed ? j.size() : 1); n++)
+    {
+        const nlohmann::json &ntf = packed ? j[n] : j;
+
+        if (ntf.size() < 2)
+        {
+            SWSS_LOG_ERROR("invalid notification on channel %s: %s", m_channel.c_str(), ntf.dump().c_str());
+            continue;
+        }
+
+        KeyOpFieldsValuesTuple kco;
+
+        kfvOp(kco) = ntf[0];
+        kfvKey(kco) = ntf[1];
+
+        auto& values = kfvFieldsValues(kco);
+
+        for (size_t i = 2; i + 1 < ntf.size(); i += 2)
+        {
+            values.emplace_back(ntf[i], ntf[i + 1]);
+        }
+
+        enqueue(kco);
+    }
+}
+
+void swss::NotificationConsumer::enqueue(KeyOpFieldsValuesTuple &kco)
+{
+    auto now = std::chrono::steady_clock::now();
+
+    if (m_queuePolicy == COALESCE)
+    {
+        auto it = m_index.find(kfvKey(kco));
+
+        if (it != m_index.end())
+        {
+            auto &last = m_queue[it->second - m_frontSeq].kco;
+
+            if (kfvOp(last) == kfvOp(kco))
+            {
+                /* Keep position and enqueue time, the entry is still waiting */
+                last = std::move(kco);
+                m_coalesced++;
+                return;
+            }
+        }
+    }
+
+    if (m_queueLimit != 0 && m_queue.size() >= m_queueLimit)
+    {
+        if (m_dropped == 0)
+        {
+            SWSS_LOG_WARN("notification queue on channel %s is full (%zu), dropping oldest notifications",
+                          m_channel.c_str(), m_queueLimit);
+        }
+
+        popFront();
+        m_dropped++;
+        m_droppedMetric.inc();
+    }
+
+    if (m_queuePolicy == COALESCE)
+    {
+        m_index[kfvKey(kco)] = m_frontSeq + m_queue.size();
+    }
+
+    m_queue.push_back({ std::move(kco), now });
+    m_queueMetric.add(1);
+}
+
+void swss::NotificationConsumer::popFront()
+{
+    if (m_queuePolicy == COALESCE)
+    {
+        const auto &kco = m_queue.front().kco;
+        auto it = m_index.find(kfvKey(kco));
+
+        if (it != m_index.end() && it->second == m_frontSeq)
+        {
+            m_index.erase(it);
+        }
+    }
+
+    m_queue.pop_front();
+    m_frontSeq++;
+    m_queueMetric.add(-1);
+}
+
+void swss::NotificationConsumer::rebuildIndex()
+{
+    m_index.clear();
+
+    if (m_queuePolicy != COALESCE)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < m_queue.size(); i++)
+    {
+        m_index[kfvKey(m_queue[i].kco)] = m_frontSeq + i;
+    }
 }
 
 void swss::NotificationConsumer::pop(std::string &op, std::string &data, std::vector<FieldValueTuple> &values)
@@ -142,15 +259,65 @@ void swss::NotificationConsumer::pop(std::string &op, std::string &data, std::ve
         throw std::runtime_error("notification queue is empty, can't pop");
     }
 
-    std::string msg = m_queue.front();
-    m_queue.pop();
+    auto &kco = m_queue.front().kco;
+
+    op = kfvOp(kco);
+    data = kfvKey(kco);
+    values = std::move(kfvFieldsValues(kco));
+
+    popFront();
+}
+
+void swss::NotificationConsumer::pops(std::deque<KeyOpFieldsValuesTuple> &vkco)
+{
+    SWSS_LOG_ENTER();
+
+    vkco.clear();
+
+    while (!m_queue.empty())
+    {
+        vkco.push_back(std::move(m_queue.front().kco));
+        popFront();
+    }
+}
+
+void swss::NotificationConsumer::setQueueLimit(size_t limit, QueuePolicy policy)
+{
+    m_queueLimit = limit;
+    m_queuePolicy = policy;
+
+    while (m_queueLimit != 0 && m_queue.size() > m_queueLimit)
+    {
+        popFront();
+        m_dropped++;
+        m_droppedMetric.inc();
+    }
+
+    rebuildIndex();
+}
+
+size_t swss::NotificationConsumer::getQueueSize() const
+{
+    return m_queue.size();
+}
 
-    JSon::readJson(msg, values);
+uint64_t swss::NotificationConsumer::getDroppedCount() const
+{
+    return m_dropped;
+}
 
-    FieldValueTuple fvt = values.at(0);
+uint64_t swss::NotificationConsumer::getCoalescedCount() const
+{
+    return m_coalesced;
+}
 
-    op = fvField(fvt);
-    data = fvValue(fvt);
+std::chrono::microseconds swss::NotificationConsumer::getOldestAge() const
+{
+    if (m_queue.empty())
+    {
+        return std::chrono::microseconds(0);
+    }
 
-    values.erase(values.begin());
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - m_queue.front().enqueued);
 }
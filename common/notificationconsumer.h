@@ -3,7 +3,10 @@
 
 #include <string>
 #include <vector>
-#include <queue>
+#include <deque>
+#include <map>
+#include <chrono>
+#include <stdint.h>
 
 #include <hiredis/hiredis.h>
 
@@ -13,16 +16,52 @@
 #include "redisreply.h"
 #include "selectable.h"
 #include "table.h"
+#include "metrics.h"
 
 namespace swss {
 
 class NotificationConsumer : public Selectable
 {
 public:
+    /* How the queue is bounded */
+    enum QueuePolicy
+    {
+        /* Drop the oldest queued notification when the queue is full */
+        DROP,
+
+        /*
+         * On every notification, replace the last queued one with the same
+         * data in place if it has the same op, so that notifications of one
+         * data are never reordered. Drop the oldest one when the queue is
+         * still full.
+         */
+        COALESCE
+    };
+
     NotificationConsumer(swss::DBConnector *db, const std::string &channel, int pri = 100);
 
     void pop(std::string &op, std::string &data, std::vector<FieldValueTuple> &values);
 
+    /*
+     * Get all queued notifications, kfvOp is the notification op and kfvKey
+     * is the notification data
+     */
+    void pops(std::deque<KeyOpFieldsValuesTuple> &vkco);
+
+    /* Bound the queue to limit notifications, 0 means unbounded */
+    void setQueueLimit(size_t limit, QueuePolicy policy = DROP);
+
+    size_t getQueueSize() const;
+
+    /* Number of notifications dropped because the queue was full */
+    uint64_t getDroppedCount() const;
+
+    /* Number of notifications merged into an already queued one */
+    uint64_t getCoalescedCount() const;
+
+    /* How long the oldest queued notification has been waiting */
+    std::chrono::microseconds getOldestAge() const;
+
     virtual ~NotificationConsumer();
 
     int getFd() override;
@@ -34,16 +73,39 @@ private:
     NotificationConsumer(const NotificationConsumer &other);
     NotificationConsumer& operator = (const NotificationConsumer &other);
 
+    struct Notification
+    {
+        KeyOpFieldsValuesTuple kco;
+        std::chrono::time_point<std::chrono::steady_clock> enqueued;
+    };
+
     void processReply(redisReply *reply);
     void subscribe();
 
+    void enqueue(KeyOpFieldsValuesTuple &kco);
+    void popFront();
+    void rebuildIndex();
+
     swss::DBConnector *m_db;
     swss::DBConnector *m_subscribe;
     std::string m_channel;
-    std::queue<std::string> m_queue;
+    std::deque<Notification> m_queue;
+
+    size_t m_queueLimit;
+    QueuePolicy m_queuePolicy;
+    uint64_t m_dropped;
+    uint64_t m_coalesced;
+
+    /* Sequence number of m_queue.front(), used to locate coalesced entries */
+    uint64_t m_frontSeq;
+    /* Sequence number of the last queued notification of each data */
+    std::map<std::string, uint64_t> m_index;
+
+    /* Shared by the consumers of the channel in the process */
+    Gauge &m_queueMetric;
+    Counter &m_droppedMetric;
 };
 
 }
 
 #endif // __NOTIFICATIONCONSUMER__
-
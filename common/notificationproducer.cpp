@@ -1,10 +1,53 @@
+#include <stdexcept>
 #include "notificationproducer.h"
 
 swss::NotificationProducer::NotificationProducer(swss::DBConnector *db, const std::string &channel):
-    m_db(db), m_channel(channel)
+    m_buffered(false),
+    m_db(db),
+    m_pipe(NULL),
+    m_channel(channel),
+    m_packSize(0)
 {
 }
 
+swss::NotificationProducer::NotificationProducer(RedisPipeline *pipeline, const std::string &channel, bool buffered):
+    m_buffered(buffered),
+    m_db(NULL),
+    m_pipe(pipeline),
+    m_channel(channel),
+    m_packSize(0)
+{
+}
+
+swss::NotificationProducer::~NotificationProducer()
+{
+    try
+    {
+        flush();
+    }
+    catch (const std::exception &e)
+    {
+        SWSS_LOG_ERROR("Unable to publish the queued notifications of channel %s: %s", m_channel.c_str(), e.what());
+    }
+}
+
+void swss::NotificationProducer::setBuffered(bool buffered)
+{
+    if (buffered && !m_pipe)
+    {
+        throw std::invalid_argument("NotificationProducer: buffering needs a pipeline");
+    }
+
+    m_buffered = buffered;
+}
+
+void swss::NotificationProducer::setPackSize(size_t packSize)
+{
+    publishPacked();
+
+    m_packSize = packSize;
+}
+
 void swss::NotificationProducer::send(const std::string &op, const std::string &data, std::vector<FieldValueTuple> &values)
 {
     SWSS_LOG_ENTER();
@@ -17,9 +60,81 @@ void swss::NotificationProducer::send(const std::string &op, const std::string &
 
     values.erase(values.begin());
 
+    if (m_buffered && m_packSize > 1)
+    {
+        m_packed.push_back(msg);
+
+        if (m_packed.size() >= m_packSize)
+        {
+            publishPacked();
+        }
+
+        return;
+    }
+
+    publish(msg);
+
+    if (!m_buffered && m_pipe)
+    {
+        m_pipe->flush();
+    }
+}
+
+void swss::NotificationProducer::flush()
+{
+    if (!m_pipe)
+    {
+        return;
+    }
+
+    publishPacked();
+
+    m_pipe->flush();
+}
+
+void swss::NotificationProducer::publish(const std::string &msg)
+{
     SWSS_LOG_DEBUG("channel %s, publish: %s", m_channel.c_str(), msg.c_str());
 
     RedisCommand publish;
     publish.format("PUBLISH %s %s", m_channel.c_str(), msg.c_str());
-    RedisReply r(m_db, publish, REDIS_REPLY_INTEGER);
+
+    if (m_pipe)
+    {
+        m_pipe->push(publish, REDIS_REPLY_INTEGER);
+    }
+    else
+    {
+        RedisReply r(m_db, publish, REDIS_REPLY_INTEGER);
+    }
+}
+
+void swss::NotificationProducer::publishPacked()
+{
+    if (m_packed.empty())
+    {
+        return;
+    }
+
+    /*
+     * Every notification is a JSON array, so the pack is an array of arrays
+     * and always starts with "[[", see NotificationConsumer::processReply
+     */
+    std::string msg = "[";
+
+    for (size_t i = 0; i < m_packed.size(); i++)
+    {
+        if (i != 0)
+        {
+            msg += ",";
+        }
+
+        msg += m_packed[i];
+    }
+
+    msg += "]";
+
+    m_packed.clear();
+
+    publish(msg);
 }
@@ -9,6 +9,7 @@
 #include "logger.h"
 #include "table.h"
 #include "redisreply.h"
+#include "redispipeline.h"
 #include "json.h"
 
 namespace swss {
@@ -16,17 +17,44 @@ namespace swss {
 class NotificationProducer
 {
 public:
+    /* Publishes synchronously on db */
     NotificationProducer(swss::DBConnector *db, const std::string &channel);
+    NotificationProducer(RedisPipeline *pipeline, const std::string &channel, bool buffered = false);
+    /* Publishes what is still queued, errors are logged */
+    virtual ~NotificationProducer();
+
+    /*
+     * In buffered mode PUBLISH commands are queued on the pipeline and only
+     * sent when the pipeline is full or on flush(). Needs a pipeline.
+     */
+    void setBuffered(bool buffered);
+
+    /*
+     * Pack up to packSize notifications into a single published message,
+     * NotificationConsumer unpacks them transparently. Only takes effect in
+     * buffered mode, 0 or 1 disables packing.
+     */
+    void setPackSize(size_t packSize);
 
     void send(const std::string &op, const std::string &data, std::vector<FieldValueTuple> &values);
 
+    void flush();
+
 private:
 
     NotificationProducer(const NotificationProducer &other);
     NotificationProducer& operator = (const NotificationProducer &other);
 
+    void publish(const std::string &msg);
+    void publishPacked();
+
+    bool m_buffered;
     swss::DBConnector *m_db;
+    /* NULL when publishing on m_db */
+    RedisPipeline *m_pipe;
     std::string m_channel;
+    size_t m_packSize;
+    std::vector<std::string> m_packed;
 };
 
 }
@@ -0,0 +1,81 @@
+#include <string>
+#include <deque>
+#include <hiredis/hiredis.h>
+#include "dbconnector.h"
+#include "table.h"
+#include "redisapi.h"
+#include "orderedconsumerstatetable.h"
+
+namespace swss {
+
+OrderedConsumerStateTable::OrderedConsumerStateTable(DBConnector *db, const std::string &tableName, int popBatchSize, int pri)
+    : ConsumerTableBase(db, tableName, popBatchSize, pri)
+    , TableName_KeyZSet(tableName)
+{
+    for (;;)
+    {
+        RedisReply watch(m_db, "WATCH " + getKeySetName(), REDIS_REPLY_STATUS);
+        watch.checkStatusOK();
+        multi();
+        enqueue(std::string("ZCARD ") + getKeySetName(), REDIS_REPLY_INTEGER);
+        subscribe(m_db, getKeySetChannelName());
+        bool succ = exec();
+        if (succ) break;
+    }
+
+    RedisReply r(dequeueReply());
+    setQueueLength(r.getReply<long long int>());
+}
+
+void OrderedConsumerStateTable::pops(std::deque<KeyOpFieldsValuesTuple> &vkco, const std::string& /*prefix*/)
+{
+    static std::string luaScript = loadLuaScript("consumer_state_table_ordered_pops.lua");
+
+    static std::string sha = loadRedisScript(m_db, luaScript);
+
+    RedisCommand command;
+    command.format(
+        "EVALSHA %s 3 %s %s: %s %d",
+        sha.c_str(),
+        getKeySetName().c_str(),
+        getTableName().c_str(),
+        getKeySetTraceName().c_str(),
+        POP_BATCH_SIZE);
+
+    RedisReply r(m_db, command, REDIS_REPLY_ARRAY);
+    auto ctx0 = r.getContext();
+    vkco.clear();
+
+    size_t n = ctx0->elements;
+    vkco.resize(n);
+    for (size_t ie = 0; ie < n; ie++)
+    {
+        auto& kco = vkco[ie];
+        auto& values = kfvFieldsValues(kco);
+
+        auto& ctx = ctx0->element[ie];
+        assert(ctx->elements == 2 || ctx->elements == 3);
+        kfvKey(kco) = ctx->element[0]->str;
+
+        auto ctx1 = ctx->element[1];
+        for (size_t i = 0; i < ctx1->elements / 2; i++)
+        {
+            FieldValueTuple e;
+            fvField(e) = ctx1->element[i * 2]->str;
+            fvValue(e) = ctx1->element[i * 2 + 1]->str;
+            values.push_back(e);
+        }
+
+        if (ctx->elements == 3)
+        {
+            trace(ctx->element[2]->str);
+        }
+
+        // if there is no field-value pair, the key is already deleted
+        kfvOp(kco) = values.empty() ? DEL_COMMAND : SET_COMMAND;
+    }
+
+    countPops(n);
+}
+
+}
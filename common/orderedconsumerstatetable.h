@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string>
+#include <deque>
+#include "dbconnector.h"
+#include "consumertablebase.h"
+
+namespace swss {
+
+/*
+ * ConsumerStateTable for tables written by OrderedProducerStateTable,
+ * pops return the keys with the highest priority first and in the order
+ * they were first notified otherwise
+ */
+class OrderedConsumerStateTable : public ConsumerTableBase, public TableName_KeyZSet
+{
+public:
+    OrderedConsumerStateTable(DBConnector *db, const std::string &tableName, int popBatchSize = DEFAULT_POP_BATCH_SIZE, int pri = 0);
+
+    /* Get multiple pop elements */
+    void pops(std::deque<KeyOpFieldsValuesTuple> &vkco, const std::string &prefix = EMPTY_PREFIX);
+};
+
+}
@@ -0,0 +1,96 @@
+#include <string>
+#include <stdexcept>
+#include "table.h"
+#include "redispipeline.h"
+#include "orderedproducerstatetable.h"
+
+using namespace std;
+
+namespace swss {
+
+/*
+ * Scores are priority then a per-table enqueue sequence, doubles hold them
+ * exactly. The sequence restarts whenever the key set is drained.
+ */
+static const long long PRIORITY_SCORE_STEP = 10000000000000LL;
+
+OrderedProducerStateTable::OrderedProducerStateTable(DBConnector *db, const string &tableName)
+    : ProducerStateTable(db, tableName)
+    , m_keyZSet(tableName)
+    , m_priority(0)
+{
+    loadScripts();
+}
+
+OrderedProducerStateTable::OrderedProducerStateTable(RedisPipeline *pipeline, const string &tableName, bool buffered)
+    : ProducerStateTable(pipeline, tableName, buffered)
+    , m_keyZSet(tableName)
+    , m_priority(0)
+{
+    loadScripts();
+}
+
+OrderedProducerStateTable::~OrderedProducerStateTable()
+{
+    /* While getKeySet() and getKeySetArg() are still ours */
+    writeCoalescedNoThrow();
+}
+
+void OrderedProducerStateTable::loadScripts()
+{
+    /*
+     * Same as ProducerStateTable with ARGV[1] being the score of the
+     * priority, the sequence being added here so that it is strictly FIFO.
+     * %.0f since Lua would print the score with 14 digits only.
+     */
+    string luaZAdd =
+        "local base = tonumber(ARGV[1])\n"
+        "local seqKey = KEYS[2] .. '_SEQ'\n"
+        "if redis.call('ZCARD', KEYS[2]) == 0 then\n"
+        "    redis.call('DEL', seqKey)\n"
+        "end\n"
+        "local score = redis.call('ZSCORE', KEYS[2], ARGV[2])\n"
+        "if not score or tonumber(score) >= base + " + to_string(PRIORITY_SCORE_STEP) + " then\n"
+        "    local seq = redis.call('INCR', seqKey)\n"
+        "    redis.call('ZADD', KEYS[2], string.format('%.0f', base + seq), ARGV[2])\n"
+        "end\n";
+
+    string luaSet = luaZAdd +
+        "for i = 0, #KEYS - 3 do\n"
+        "    redis.call('HSET', KEYS[3 + i], ARGV[3 + i * 2], ARGV[4 + i * 2])\n"
+        "end\n"
+        "redis.call('PUBLISH', KEYS[1], 'G')\n";
+    m_shaSet = m_pipe->loadRedisScript(luaSet);
+
+    string luaDel = luaZAdd +
+        "redis.call('DEL', KEYS[3])\n"
+        "redis.call('PUBLISH', KEYS[1], 'G')\n";
+    m_shaDel = m_pipe->loadRedisScript(luaDel);
+}
+
+void OrderedProducerStateTable::setPriority(int priority)
+{
+    if (priority < 0 || priority > MAX_PRIORITY)
+    {
+        throw invalid_argument("Priority out of range");
+    }
+
+    m_priority = priority;
+}
+
+int OrderedProducerStateTable::getPriority() const
+{
+    return m_priority;
+}
+
+const TableName_KeySet &OrderedProducerStateTable::getKeySet(const string& /*key*/) const
+{
+    return m_keyZSet;
+}
+
+string OrderedProducerStateTable::getKeySetArg(const string& /*key*/)
+{
+    return to_string((MAX_PRIORITY - m_priority) * PRIORITY_SCORE_STEP);
+}
+
+}
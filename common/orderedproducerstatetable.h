@@ -0,0 +1,43 @@
+#pragma once
+
+#include <string>
+#include "table.h"
+#include "redispipeline.h"
+#include "producerstatetable.h"
+
+namespace swss {
+
+/*
+ * ProducerStateTable notifying keys on a sorted key set, drained by
+ * OrderedConsumerStateTable by priority first and enqueue order second.
+ * A key already waiting keeps its place unless notified with a higher
+ * priority.
+ */
+class OrderedProducerStateTable : public ProducerStateTable
+{
+public:
+    static constexpr int MAX_PRIORITY = 99;
+
+    OrderedProducerStateTable(DBConnector *db, const std::string &tableName);
+    OrderedProducerStateTable(RedisPipeline *pipeline, const std::string &tableName, bool buffered = false);
+    ~OrderedProducerStateTable() override;
+
+    /* Priority of the following set() and del(), 0 (default) to MAX_PRIORITY.
+     * Coalesced entries get the priority current at flush() */
+    void setPriority(int priority);
+    int getPriority() const;
+
+protected:
+    const TableName_KeySet &getKeySet(const std::string &key) const override;
+
+    /* Score of the key in the sorted key set */
+    std::string getKeySetArg(const std::string &key) override;
+
+private:
+    void loadScripts();
+
+    TableName_KeyZSet m_keyZSet;
+    int m_priority;
+};
+
+}
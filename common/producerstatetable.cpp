@@ -7,6 +7,8 @@
 #include "table.h"
 #include "redisapi.h"
 #include "redispipeline.h"
+#include "logger.h"
+#include "tracing.h"
 #include "producerstatetable.h"
 
 using namespace std;
@@ -25,6 +27,9 @@ ProducerStateTable::ProducerStateTable(RedisPipeline *pipeline, const string &ta
     , m_buffered(buffered)
     , m_pipeowned(false)
     , m_pipe(pipeline)
+    , m_coalescing(false)
+    , m_tracing(false)
+    , m_coalesced(0)
 {
     string luaSet =
         "redis.call('SADD', KEYS[2], ARGV[2])\n"
@@ -43,8 +48,29 @@ ProducerStateTable::ProducerStateTable(RedisPipeline *pipeline, const string &ta
 
 ProducerStateTable::~ProducerStateTable()
 {
+    /* The pipeline is flushed by its owner */
+    writeCoalescedNoThrow();
+
     if (m_pipeowned)
     {
+        /* Flushed here as ~RedisPipeline must not throw, each failed reply
+         * is consumed so the loop ends even if the connection is gone */
+        size_t failed = 0;
+        while (m_pipe->size() > 0)
+        {
+            try
+            {
+                m_pipe->flush();
+            }
+            catch (const exception &e)
+            {
+                if (failed++ == 0)
+                {
+                    SWSS_LOG_ERROR("Unable to flush the entries of %s: %s", getTableName().c_str(), e.what());
+                }
+            }
+        }
+
         delete m_pipe;
     }
 }
@@ -54,20 +80,113 @@ void ProducerStateTable::setBuffered(bool buffered)
     m_buffered = buffered;
 }
 
+void ProducerStateTable::setCoalescing(bool coalescing)
+{
+    if (!coalescing)
+    {
+        writeCoalesced();
+    }
+    m_coalescing = coalescing;
+}
+
+void ProducerStateTable::setTracing(bool tracing)
+{
+    m_tracing = tracing;
+}
+
+uint64_t ProducerStateTable::getCoalescedCount() const
+{
+    return m_coalesced;
+}
+
+void ProducerStateTable::multi()
+{
+    /* Entries pending before the transaction are not part of it */
+    writeCoalesced();
+    m_pipe->multi();
+}
+
+void ProducerStateTable::exec()
+{
+    writeCoalesced();
+    m_pipe->exec();
+    if (!m_buffered)
+    {
+        m_pipe->flush();
+    }
+}
+
 void ProducerStateTable::set(const string &key, const vector<FieldValueTuple> &values,
                  const string &op /*= SET_COMMAND*/, const string &prefix)
+{
+    if (!m_coalescing)
+    {
+        writeSet(key, values);
+        if (!m_buffered && !m_pipe->inTransaction())
+        {
+            m_pipe->flush();
+        }
+        return;
+    }
+
+    auto it = m_coalesceOps.find(key);
+    if (it == m_coalesceOps.end())
+    {
+        PendingOp pending;
+        pending.del = false;
+        pending.set = true;
+        pending.values = values;
+        m_coalesceOps.emplace(key, pending);
+        m_coalesceOrder.push_back(key);
+    }
+    else
+    {
+        PendingOp &pending = it->second;
+        m_coalesced++;
+
+        if (!pending.set)
+        {
+            pending.set = true;
+            pending.values = values;
+        }
+        else
+        {
+            for (const auto &fv: values)
+            {
+                auto f = find_if(pending.values.begin(), pending.values.end(),
+                        [&fv](const FieldValueTuple &p) { return fvField(p) == fvField(fv); });
+                if (f == pending.values.end())
+                {
+                    pending.values.push_back(fv);
+                }
+                else
+                {
+                    fvValue(*f) = fvValue(fv);
+                }
+            }
+        }
+    }
+
+    if (!m_buffered && !m_pipe->inTransaction())
+    {
+        flush();
+    }
+}
+
+void ProducerStateTable::writeSet(const string &key, const vector<FieldValueTuple> &values)
 {
     // Assembly redis command args into a string vector
     vector<string> args;
     args.push_back("EVALSHA");
     args.push_back(m_shaSet);
     args.push_back(to_string(values.size() + 2));
-    args.push_back(getChannelName());
-    args.push_back(getKeySetName());
+    const TableName_KeySet &keySet = getKeySet(key);
+    args.push_back(keySet.getKeySetChannelName());
+    args.push_back(keySet.getKeySetName());
 
     args.insert(args.end(), values.size(), getKeyName(key));
 
-    args.push_back("G");
+    args.push_back(getKeySetArg(key));
     args.push_back(key);
     for (const auto& iv: values)
     {
@@ -79,27 +198,61 @@ void ProducerStateTable::set(const string &key, const vector<FieldValueTuple> &v
     vector<const char *> args1;
     transform(args.begin(), args.end(), back_inserter(args1), [](const string &s) { return s.c_str(); } );
 
+    writeTrace(key);
+
     // Invoke redis command
     RedisCommand command;
     command.formatArgv((int)args1.size(), &args1[0], NULL);
     m_pipe->push(command, REDIS_REPLY_NIL);
-    if (!m_buffered)
+}
+
+void ProducerStateTable::del(const string &key, const string &op /*= DEL_COMMAND*/, const string &prefix)
+{
+    if (!m_coalescing)
     {
-        m_pipe->flush();
+        writeDel(key);
+        if (!m_buffered && !m_pipe->inTransaction())
+        {
+            m_pipe->flush();
+        }
+        return;
+    }
+
+    auto it = m_coalesceOps.find(key);
+    if (it == m_coalesceOps.end())
+    {
+        PendingOp pending;
+        pending.del = true;
+        pending.set = false;
+        m_coalesceOps.emplace(key, pending);
+        m_coalesceOrder.push_back(key);
+    }
+    else
+    {
+        m_coalesced++;
+        it->second.del = true;
+        it->second.set = false;
+        it->second.values.clear();
+    }
+
+    if (!m_buffered && !m_pipe->inTransaction())
+    {
+        flush();
     }
 }
 
-void ProducerStateTable::del(const string &key, const string &op /*= DEL_COMMAND*/, const string &prefix)
+void ProducerStateTable::writeDel(const string &key)
 {
     // Assembly redis command args into a string vector
     vector<string> args;
     args.push_back("EVALSHA");
     args.push_back(m_shaDel);
     args.push_back("3");
-    args.push_back(getChannelName());
-    args.push_back(getKeySetName());
+    const TableName_KeySet &keySet = getKeySet(key);
+    args.push_back(keySet.getKeySetChannelName());
+    args.push_back(keySet.getKeySetName());
     args.push_back(getKeyName(key));
-    args.push_back("G");
+    args.push_back(getKeySetArg(key));
     args.push_back(key);
     args.push_back("''");
 
@@ -107,18 +260,80 @@ void ProducerStateTable::del(const string &key, const string &op /*= DEL_COMMAND
     vector<const char *> args1;
     transform(args.begin(), args.end(), back_inserter(args1), [](const string &s) { return s.c_str(); } );
 
+    writeTrace(key);
+
     // Invoke redis command
     RedisCommand command;
     command.formatArgv((int)args1.size(), &args1[0], NULL);
     m_pipe->push(command, REDIS_REPLY_NIL);
-    if (!m_buffered)
+}
+
+void ProducerStateTable::writeTrace(const string &key)
+{
+    if (!m_tracing)
     {
-        m_pipe->flush();
+        return;
     }
+
+    // Keep the trace of the oldest write the consumer has not popped yet
+    RedisCommand command;
+    command.format(
+        "HSETNX %s %s %s",
+        getKeySet(key).getKeySetTraceName().c_str(),
+        key.c_str(),
+        Tracing::make().c_str());
+    m_pipe->push(command, REDIS_REPLY_INTEGER);
+}
+
+void ProducerStateTable::writeCoalesced()
+{
+    for (const auto &key: m_coalesceOrder)
+    {
+        const PendingOp &pending = m_coalesceOps[key];
+
+        /* Both are seen by the consumer as a single set of the new fields */
+        if (pending.del)
+        {
+            writeDel(key);
+        }
+        if (pending.set)
+        {
+            writeSet(key, pending.values);
+        }
+    }
+
+    m_coalesceOps.clear();
+    m_coalesceOrder.clear();
+}
+
+void ProducerStateTable::writeCoalescedNoThrow()
+{
+    try
+    {
+        writeCoalesced();
+    }
+    catch (const exception &e)
+    {
+        SWSS_LOG_ERROR("Unable to write the coalesced entries of %s: %s", getTableName().c_str(), e.what());
+
+        m_coalesceOps.clear();
+        m_coalesceOrder.clear();
+    }
+}
+
+const TableName_KeySet &ProducerStateTable::getKeySet(const string& /*key*/) const
+{
+    return *this;
+}
+
+string ProducerStateTable::getKeySetArg(const string& /*key*/)
+{
+    return "G";
 }
 
 void ProducerStateTable::flush()
 {
+    writeCoalesced();
     m_pipe->flush();
 }
 
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <memory>
+#include <unordered_map>
+#include <stdint.h>
 #include "table.h"
 #include "redispipeline.h"
 
@@ -11,7 +13,7 @@ class ProducerStateTable : public TableBase, public TableName_KeySet
 public:
     ProducerStateTable(DBConnector *db, const std::string &tableName);
     ProducerStateTable(RedisPipeline *pipeline, const std::string &tableName, bool buffered = false);
-    ~ProducerStateTable();
+    virtual ~ProducerStateTable();
 
     void setBuffered(bool buffered);
     /* Implements set() and del() commands using notification messages */
@@ -24,14 +26,70 @@ public:
                      const std::string &op = DEL_COMMAND,
                      const std::string &prefix = EMPTY_PREFIX);
 
-    void flush();
+    virtual void flush();
 
-private:
+    /*
+     * Merge pending operations per key until flush(), only the net change
+     * is written: successive sets are merged field by field, a del drops
+     * the sets before it and a del followed by a set is written together.
+     */
+    void setCoalescing(bool coalescing);
+
+    /*
+     * Apply the set() and del() calls up to exec() atomically. MULTI, the
+     * commands and EXEC are sent in one write and the replies checked in
+     * one read, at exec() or, when buffered, at the next flush(). Other
+     * tables on the same pipeline join the transaction.
+     */
+    void multi();
+    void exec();
+
+    /* Trace entries when written to the pipeline, see Tracing */
+    void setTracing(bool tracing);
+
+    /* Number of operations merged into a pending one */
+    uint64_t getCoalescedCount() const;
+
+protected:
     bool m_buffered;
     bool m_pipeowned;
     RedisPipeline *m_pipe;
     std::string m_shaSet;
     std::string m_shaDel;
+
+    bool m_coalescing;
+    bool m_tracing;
+
+    /* Key set and channel an entry is notified on */
+    virtual const TableName_KeySet &getKeySet(const std::string &key) const;
+
+    /* First argument of the scripts, the message published on the channel */
+    virtual std::string getKeySetArg(const std::string &key);
+
+    /*
+     * Write the coalesced entries from a destructor, logging failures.
+     * Classes overriding getKeySet() or getKeySetArg() call it from their
+     * own destructor, the overrides are gone when the base one runs.
+     */
+    void writeCoalescedNoThrow();
+
+private:
+    struct PendingOp
+    {
+        bool del;
+        bool set;
+        std::vector<FieldValueTuple> values;
+    };
+
+    void writeSet(const std::string &key, const std::vector<FieldValueTuple> &values);
+    void writeDel(const std::string &key);
+    void writeTrace(const std::string &key);
+    void writeCoalesced();
+
+    std::unordered_map<std::string, PendingOp> m_coalesceOps;
+    /* Keys in order of their first pending operation */
+    std::vector<std::string> m_coalesceOrder;
+    uint64_t m_coalesced;
 };
 
 }
@@ -0,0 +1,91 @@
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "redisreply.h"
+#include "table.h"
+#include "redispipeline.h"
+#include "producerstreamtable.h"
+
+using namespace std;
+
+namespace swss {
+
+ProducerStreamTable::ProducerStreamTable(DBConnector *db, const string &tableName)
+    : ProducerStreamTable(new RedisPipeline(db, 1), tableName, false)
+{
+    m_pipeowned = true;
+}
+
+ProducerStreamTable::ProducerStreamTable(RedisPipeline *pipeline, const string &tableName, bool buffered)
+    : TableBase(pipeline->getDbId(), tableName)
+    , TableName_Stream(tableName)
+    , m_buffered(buffered)
+    , m_pipeowned(false)
+    , m_pipe(pipeline)
+{
+    /* Wrapped in a script so the reply is NIL and XADD can be pipelined */
+    string luaAdd =
+        "redis.call('XADD', KEYS[1], '*', unpack(ARGV))\n";
+    m_shaAdd = m_pipe->loadRedisScript(luaAdd);
+}
+
+ProducerStreamTable::~ProducerStreamTable()
+{
+    if (m_pipeowned)
+    {
+        delete m_pipe;
+    }
+}
+
+void ProducerStreamTable::setBuffered(bool buffered)
+{
+    m_buffered = buffered;
+}
+
+void ProducerStreamTable::enqueueDbChange(const string &key, const string &op, const vector<FieldValueTuple> &values)
+{
+    // Assembly redis command args into a string vector
+    vector<string> args;
+    args.push_back("EVALSHA");
+    args.push_back(m_shaAdd);
+    args.push_back("1");
+    args.push_back(getStreamName());
+    args.push_back(key);
+    args.push_back(op);
+    for (const auto& iv: values)
+    {
+        args.push_back(fvField(iv));
+        args.push_back(fvValue(iv));
+    }
+
+    // Transform data structure
+    vector<const char *> args1;
+    transform(args.begin(), args.end(), back_inserter(args1), [](const string &s) { return s.c_str(); } );
+
+    // Invoke redis command
+    RedisCommand command;
+    command.formatArgv((int)args1.size(), &args1[0], NULL);
+    m_pipe->push(command, REDIS_REPLY_NIL);
+    if (!m_buffered)
+    {
+        m_pipe->flush();
+    }
+}
+
+void ProducerStreamTable::set(const string &key, const vector<FieldValueTuple> &values,
+                              const string &op, const string& /*prefix*/)
+{
+    enqueueDbChange(key, op, values);
+}
+
+void ProducerStreamTable::del(const string &key, const string &op, const string& /*prefix*/)
+{
+    enqueueDbChange(key, op, vector<FieldValueTuple>());
+}
+
+void ProducerStreamTable::flush()
+{
+    m_pipe->flush();
+}
+
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "table.h"
+#include "redispipeline.h"
+
+namespace swss {
+
+/*
+ * ProducerTable variant backed by a single Redis stream (requires Redis 5.0)
+ *
+ * Every set() or del() is one XADD of [key, op, field, value, ...] to the
+ * stream of the table, to be read by ConsumerStreamTable.
+ */
+class ProducerStreamTable : public TableBase, public TableName_Stream
+{
+public:
+    ProducerStreamTable(DBConnector *db, const std::string &tableName);
+    ProducerStreamTable(RedisPipeline *pipeline, const std::string &tableName, bool buffered = false);
+    virtual ~ProducerStreamTable();
+
+    void setBuffered(bool buffered);
+
+    virtual void set(const std::string &key,
+                     const std::vector<FieldValueTuple> &values,
+                     const std::string &op = SET_COMMAND,
+                     const std::string &prefix = EMPTY_PREFIX);
+
+    virtual void del(const std::string &key,
+                     const std::string &op = DEL_COMMAND,
+                     const std::string &prefix = EMPTY_PREFIX);
+
+    void flush();
+
+private:
+    /* Disable copy-constructor and operator = */
+    ProducerStreamTable(const ProducerStreamTable &other);
+    ProducerStreamTable & operator = (const ProducerStreamTable &other);
+
+    void enqueueDbChange(const std::string &key, const std::string &op, const std::vector<FieldValueTuple> &values);
+
+    bool m_buffered;
+    bool m_pipeowned;
+    RedisPipeline *m_pipe;
+    std::string m_shaAdd;
+};
+
+}
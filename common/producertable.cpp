@@ -6,6 +6,7 @@
 #include "common/json.hpp"
 #include "common/logger.h"
 #include "common/redisapi.h"
+#include "common/tracing.h"
 
 using namespace std;
 using json = nlohmann::json;
@@ -24,6 +25,7 @@ ProducerTable::ProducerTable(RedisPipeline *pipeline, const string &tableName, b
     , m_buffered(buffered)
     , m_pipeowned(false)
     , m_pipe(pipeline)
+    , m_tracing(false)
 {
     string luaEnque =
         "redis.call('LPUSH', KEYS[1], ARGV[1]);"
@@ -59,6 +61,21 @@ void ProducerTable::setBuffered(bool buffered)
     m_buffered = buffered;
 }
 
+void ProducerTable::setTracing(bool tracing)
+{
+    m_tracing = tracing;
+}
+
+string ProducerTable::getOp(const string &dbop, const string &op) const
+{
+    if (!m_tracing)
+    {
+        return dbop + op;
+    }
+
+    return dbop + op + Tracing::OP_SEPARATOR + Tracing::make();
+}
+
 void ProducerTable::enqueueDbChange(const string &key, const string &value, const string &op, const string& /* prefix */)
 {
     RedisCommand command;
@@ -95,7 +112,7 @@ void ProducerTable::set(const string &key, const vector<FieldValueTuple> &values
         m_dumpFile << j.dump(4);
     }
 
-    enqueueDbChange(key, JSon::buildJson(values), "S" + op, prefix);
+    enqueueDbChange(key, JSon::buildJson(values), getOp("S", op), prefix);
     // Only buffer continuous "set/set" or "del" operations
     if (!m_buffered || (op != "set" && op != "bulkset" ))
     {
@@ -119,7 +136,7 @@ void ProducerTable::del(const string &key, const string &op, const string &prefi
         m_dumpFile << j.dump(4);
     }
 
-    enqueueDbChange(key, "{}", "D" + op, prefix);
+    enqueueDbChange(key, "{}", getOp("D", op), prefix);
     if (!m_buffered)
     {
         m_pipe->flush();
@@ -37,6 +37,9 @@ public:
 
     void flush();
 
+    /* Append a trace to the queued ops, see Tracing */
+    void setTracing(bool tracing);
+
 private:
     /* Disable copy-constructor and operator = */
     ProducerTable(const ProducerTable &other);
@@ -48,7 +51,10 @@ private:
     bool m_pipeowned;
     RedisPipeline *m_pipe;
     std::string m_shaEnque;
+    bool m_tracing;
 
+    /* Queued op, the DB operation prefix then op then the trace if any */
+    std::string getOp(const std::string &dbop, const std::string &op) const;
     void enqueueDbChange(const std::string &key, const std::string &value, const std::string &op, const std::string &prefix);
 };
 
@@ -0,0 +1,90 @@
+#include <algorithm>
+#include "common/logger.h"
+#include "common/rawnetdispatcher.h"
+
+using namespace swss;
+
+RawNetDispatcher::RawNetDispatcher()
+{
+}
+
+RawNetDispatcher::~RawNetDispatcher()
+{
+}
+
+RawNetDispatcher& RawNetDispatcher::getInstance()
+{
+    static RawNetDispatcher gInstance;
+    return gInstance;
+}
+
+void RawNetDispatcher::registerMessageHandler(uint16_t nlmsg_type, RawNetMsg *callback)
+{
+    if (nlmsg_type < m_handlers.size() && m_handlers[nlmsg_type])
+        throw "Trying to registered on already registerd netlink message";
+
+    if (nlmsg_type >= m_handlers.size())
+        m_handlers.resize(nlmsg_type + 1, NULL);
+
+    m_handlers[nlmsg_type] = callback;
+}
+
+void RawNetDispatcher::unregisterMessageHandler(uint16_t nlmsg_type)
+{
+    if (nlmsg_type < m_handlers.size())
+        m_handlers[nlmsg_type] = NULL;
+}
+
+void RawNetDispatcher::onNetlinkMessages(const char *buf, size_t len)
+{
+    size_t offset = 0;
+
+    while (len - offset >= sizeof(struct nlmsghdr))
+    {
+        auto msg = reinterpret_cast<const struct nlmsghdr *>(buf + offset);
+        if (msg->nlmsg_len < sizeof(struct nlmsghdr) || msg->nlmsg_len > len - offset)
+            break;
+
+        onNetlinkMessage(msg);
+
+        /* The padding of the last message may be missing from the buffer */
+        offset += std::min<size_t>(NLMSG_ALIGN(msg->nlmsg_len), len - offset);
+    }
+
+    if (offset < len)
+        SWSS_LOG_ERROR("Dropping %zu bytes of truncated netlink message", len - offset);
+}
+
+void RawNetDispatcher::onOverrun()
+{
+    std::vector<RawNetMsg *> notified;
+
+    for (auto handler : m_handlers)
+    {
+        if (!handler || std::find(notified.begin(), notified.end(), handler) != notified.end())
+            continue;
+
+        notified.push_back(handler);
+        handler->onOverrun();
+    }
+}
+
+void RawNetDispatcher::onNetlinkMessage(const struct nlmsghdr *msg)
+{
+    if (msg->nlmsg_type == NLMSG_ERROR)
+    {
+        auto err = netlinkHeader<struct nlmsgerr>(msg);
+        if (err && err->error)
+            SWSS_LOG_ERROR("netlink reports error=%d for request %u", err->error, msg->nlmsg_seq);
+        return;
+    }
+
+    if (msg->nlmsg_flags & NLM_F_DUMP_INTR)
+        SWSS_LOG_WARN("netlink dump of type %u was interrupted by a change, it may be inconsistent", msg->nlmsg_type);
+
+    /* Drop not registered messages */
+    if (msg->nlmsg_type >= m_handlers.size() || !m_handlers[msg->nlmsg_type])
+        return;
+
+    m_handlers[msg->nlmsg_type]->onMsg(msg);
+}
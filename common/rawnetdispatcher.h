@@ -0,0 +1,47 @@
+#ifndef __RAWNETDISPATCHER__
+#define __RAWNETDISPATCHER__
+
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rawnetmsg.h"
+
+namespace swss {
+
+/*
+ * Counterpart of NetDispatcher handing messages to handlers as received,
+ * without libnl parsing them into objects first
+ */
+class RawNetDispatcher {
+public:
+    static RawNetDispatcher& getInstance();
+
+    /*
+     * Register callback class according to message-type.
+     *
+     * Throw exception if already registered
+     */
+    void registerMessageHandler(uint16_t nlmsg_type, RawNetMsg *callback);
+
+    void unregisterMessageHandler(uint16_t nlmsg_type);
+
+    /* Dispatch the messages of a buffer read from a netlink socket */
+    void onNetlinkMessages(const char *buf, size_t len);
+
+    void onNetlinkMessage(const struct nlmsghdr *msg);
+
+    /* Tell every registered handler, once, that messages were lost */
+    void onOverrun();
+
+private:
+    RawNetDispatcher();
+    ~RawNetDispatcher();
+
+    /* Indexed by message type */
+    std::vector<RawNetMsg *> m_handlers;
+};
+
+}
+
+#endif
@@ -0,0 +1,144 @@
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <system_error>
+#include "common/logger.h"
+#include "common/rawnetdispatcher.h"
+#include "common/rawnetlink.h"
+
+using namespace swss;
+using namespace std;
+
+const size_t RawNetLink::DATAGRAMS_PER_READ;
+const size_t RawNetLink::DATAGRAM_SIZE;
+
+RawNetLink::RawNetLink(int pri) :
+    Selectable(pri), m_fd(-1), m_seq(0),
+    m_overruns(MetricsRegistry::getInstance().getCounter("netlink.overruns"))
+{
+    m_fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC | SOCK_NONBLOCK, NETLINK_ROUTE);
+    if (m_fd < 0)
+    {
+        SWSS_LOG_ERROR("Unable to allocate netlink socket: %s", strerror(errno));
+        throw system_error(errno, system_category(), "Unable to allocate netlink socket");
+    }
+
+    struct sockaddr_nl addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.nl_family = AF_NETLINK;
+
+    if (bind(m_fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) < 0)
+    {
+        int err = errno;
+        SWSS_LOG_ERROR("Unable to bind netlink socket: %s", strerror(err));
+        close(m_fd);
+        throw system_error(err, system_category(), "Unable to bind netlink socket");
+    }
+
+    /* Same 2MB receive buffer as NetLink */
+    int size = 2097152;
+    if (setsockopt(m_fd, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size)) < 0)
+        SWSS_LOG_WARN("Unable to set netlink socket buffer size: %s", strerror(errno));
+
+    m_buffer.resize(DATAGRAMS_PER_READ * DATAGRAM_SIZE);
+    m_iovecs.resize(DATAGRAMS_PER_READ);
+    m_msgs.resize(DATAGRAMS_PER_READ);
+
+    for (size_t i = 0; i < DATAGRAMS_PER_READ; i++)
+    {
+        m_iovecs[i].iov_base = &m_buffer[i * DATAGRAM_SIZE];
+        m_iovecs[i].iov_len = DATAGRAM_SIZE;
+    }
+}
+
+RawNetLink::~RawNetLink()
+{
+    close(m_fd);
+}
+
+void RawNetLink::registerGroup(int rtnlGroup)
+{
+    if (setsockopt(m_fd, SOL_NETLINK, NETLINK_ADD_MEMBERSHIP, &rtnlGroup, sizeof(rtnlGroup)) < 0)
+    {
+        SWSS_LOG_ERROR("Unable to register to group %d: %s", rtnlGroup, strerror(errno));
+        throw system_error(make_error_code(errc::address_not_available),
+                           "Unable to register group");
+    }
+}
+
+void RawNetLink::dumpRequest(int rtmGetCommand)
+{
+    struct
+    {
+        struct nlmsghdr hdr;
+        struct rtgenmsg gen;
+    } req;
+
+    memset(&req, 0, sizeof(req));
+    req.hdr.nlmsg_len = sizeof(req);
+    req.hdr.nlmsg_type = static_cast<uint16_t>(rtmGetCommand);
+    req.hdr.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    req.hdr.nlmsg_seq = ++m_seq;
+    req.gen.rtgen_family = AF_UNSPEC;
+
+    if (send(m_fd, &req, sizeof(req), 0) < 0)
+    {
+        SWSS_LOG_ERROR("Unable to request dump on group %d: %s", rtmGetCommand, strerror(errno));
+        throw system_error(make_error_code(errc::address_not_available),
+                           "Unable to request dump");
+    }
+}
+
+int RawNetLink::getFd()
+{
+    return m_fd;
+}
+
+void RawNetLink::readData()
+{
+    for (int reads = 0; reads < MAX_READS_PER_EVENT; reads++)
+    {
+        for (size_t i = 0; i < DATAGRAMS_PER_READ; i++)
+        {
+            memset(&m_msgs[i].msg_hdr, 0, sizeof(m_msgs[i].msg_hdr));
+            m_msgs[i].msg_hdr.msg_iov = &m_iovecs[i];
+            m_msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        int count = recvmmsg(m_fd, m_msgs.data(), static_cast<unsigned int>(DATAGRAMS_PER_READ), MSG_DONTWAIT, NULL);
+        if (count < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            if (errno == ENOBUFS)
+            {
+                SWSS_LOG_ERROR("netlink socket overrun. High possiblity of a lost message");
+                m_overruns.inc();
+                onOverrun();
+            }
+            else if (errno != EAGAIN)
+                SWSS_LOG_ERROR("netlink reports an error=%d on reading a netlink socket", errno);
+            return;
+        }
+
+        for (int i = 0; i < count; i++)
+        {
+            if (m_msgs[i].msg_hdr.msg_flags & MSG_TRUNC)
+            {
+                SWSS_LOG_ERROR("Dropping netlink datagram larger than %zu bytes", DATAGRAM_SIZE);
+                continue;
+            }
+
+            RawNetDispatcher::getInstance().onNetlinkMessages(&m_buffer[static_cast<size_t>(i) * DATAGRAM_SIZE],
+                                                              m_msgs[i].msg_len);
+        }
+
+        if (static_cast<size_t>(count) < DATAGRAMS_PER_READ)
+            return;
+    }
+}
+
+void RawNetLink::onOverrun()
+{
+    RawNetDispatcher::getInstance().onOverrun();
+}
@@ -0,0 +1,56 @@
+#ifndef __RAWNETLINK__
+#define __RAWNETLINK__
+
+#include <vector>
+#include <sys/socket.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include "selectable.h"
+#include "metrics.h"
+
+namespace swss {
+
+/*
+ * NETLINK_ROUTE socket feeding RawNetDispatcher
+ *
+ * Unlike NetLink it does not go through libnl: readData() receives up to
+ * DATAGRAMS_PER_READ datagrams per recvmmsg() call into a buffer allocated
+ * once, and the messages are dispatched from there without being copied.
+ * Socket overruns are counted in netlink.overruns and reported through
+ * onOverrun(), by default to the handlers, which resynchronise themselves.
+ */
+class RawNetLink : public Selectable {
+public:
+    static const size_t DATAGRAMS_PER_READ = 16;
+    /* Largest datagram the kernel sends for dumps */
+    static const size_t DATAGRAM_SIZE = 32768;
+
+    RawNetLink(int pri = 0);
+    virtual ~RawNetLink();
+
+    void registerGroup(int rtnlGroup);
+    void dumpRequest(int rtmGetCommand);
+
+    int getFd() override;
+    void readData() override;
+
+protected:
+    /* Messages were lost, RawNetDispatcher::onOverrun() by default */
+    virtual void onOverrun();
+
+private:
+    /* recvmmsg() calls per readData() */
+    static const int MAX_READS_PER_EVENT = 8;
+
+    int m_fd;
+    uint32_t m_seq;
+    std::vector<char> m_buffer;
+    std::vector<struct iovec> m_iovecs;
+    std::vector<struct mmsghdr> m_msgs;
+
+    Counter &m_overruns;
+};
+
+}
+
+#endif
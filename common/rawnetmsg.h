@@ -0,0 +1,136 @@
+#ifndef __RAWNETMSG__
+#define __RAWNETMSG__
+
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <string.h>
+
+namespace swss {
+
+/* Family header (ifinfomsg, rtmsg, ...) of msg, NULL if the message is too short */
+template <typename T>
+inline const T *netlinkHeader(const struct nlmsghdr *msg)
+{
+    if (msg->nlmsg_len < NLMSG_LENGTH(sizeof(T)))
+        return NULL;
+
+    return static_cast<const T *>(NLMSG_DATA(msg));
+}
+
+/*
+ * Attributes of a netlink message indexed by type, pointing into the
+ * message, which must outlive them. Types above MAX are ignored, as are
+ * malformed attributes: parsing stops at the first one.
+ */
+template <unsigned short MAX>
+class NetlinkAttrs
+{
+public:
+    /* Attributes following the family header T of msg */
+    template <typename T>
+    static NetlinkAttrs parse(const struct nlmsghdr *msg)
+    {
+        NetlinkAttrs attrs;
+
+        if (msg->nlmsg_len >= NLMSG_LENGTH(sizeof(T)))
+        {
+            auto first = reinterpret_cast<const char *>(msg) + NLMSG_SPACE(sizeof(T));
+            auto end = reinterpret_cast<const char *>(msg) + msg->nlmsg_len;
+            attrs.add(first, end);
+        }
+
+        return attrs;
+    }
+
+    /* Attributes nested in attr */
+    static NetlinkAttrs parseNested(const struct rtattr *attr)
+    {
+        NetlinkAttrs attrs;
+
+        if (attr)
+        {
+            auto first = reinterpret_cast<const char *>(RTA_DATA(attr));
+            attrs.add(first, reinterpret_cast<const char *>(attr) + attr->rta_len);
+        }
+
+        return attrs;
+    }
+
+    inline const struct rtattr *get(unsigned short type) const
+    {
+        return type <= MAX ? m_attrs[type] : NULL;
+    }
+
+    inline bool has(unsigned short type) const
+    {
+        return get(type) != NULL;
+    }
+
+    /* Fixed size value of attribute type, or def when missing or short */
+    template <typename V>
+    inline V getValue(unsigned short type, V def = V()) const
+    {
+        const struct rtattr *attr = get(type);
+
+        if (attr && RTA_PAYLOAD(attr) >= sizeof(V))
+            memcpy(&def, RTA_DATA(attr), sizeof(V));
+
+        return def;
+    }
+
+    /* NUL terminated string attribute, NULL when missing or not terminated */
+    inline const char *getString(unsigned short type) const
+    {
+        const struct rtattr *attr = get(type);
+
+        if (!attr || RTA_PAYLOAD(attr) == 0)
+            return NULL;
+
+        auto str = static_cast<const char *>(RTA_DATA(attr));
+        return memchr(str, '\0', RTA_PAYLOAD(attr)) ? str : NULL;
+    }
+
+private:
+    NetlinkAttrs()
+    {
+        memset(m_attrs, 0, sizeof(m_attrs));
+    }
+
+    void add(const char *p, const char *end)
+    {
+        while (end - p >= static_cast<long>(sizeof(struct rtattr)))
+        {
+            auto attr = reinterpret_cast<const struct rtattr *>(p);
+            if (attr->rta_len < sizeof(struct rtattr) || attr->rta_len > end - p)
+                return;
+
+            /* The NLA_F_NESTED and NLA_F_NET_BYTEORDER flags share the type */
+            unsigned short type = attr->rta_type & NLA_TYPE_MASK;
+            if (type <= MAX)
+                m_attrs[type] = attr;
+
+            p += RTA_ALIGN(attr->rta_len);
+        }
+    }
+
+    const struct rtattr *m_attrs[MAX + 1];
+};
+
+class RawNetMsg {
+public:
+    /*
+     * Called by RawNetDispatcher for the messages of the registered type.
+     * msg points into the receive buffer and is only valid during the call.
+     */
+    virtual void onMsg(const struct nlmsghdr *msg) = 0;
+
+    /*
+     * Called when the socket overran and messages were lost, e.g. to
+     * request the dumps again
+     */
+    virtual void onOverrun() {}
+};
+
+}
+
+#endif
@@ -1,10 +1,15 @@
 #pragma once
 
 #include <string>
+#include <queue>
+#include <vector>
+#include <stdexcept>
 #include <functional>
 #include "redisreply.h"
 #include "rediscommand.h"
 #include "dbconnector.h"
+#include "logger.h"
+#include "metrics.h"
 
 namespace swss {
 
@@ -16,6 +21,10 @@ public:
     RedisPipeline(DBConnector *db, size_t sz = 128)
         : COMMAND_MAX(sz)
         , m_remaining(0)
+        , m_inTransaction(false)
+        , m_commandsMetric(getMetrics().getCounter(getMetricName(db, "commands")))
+        , m_flushesMetric(getMetrics().getCounter(getMetricName(db, "flushes")))
+        , m_bytesMetric(getMetrics().getCounter(getMetricName(db, "bytes")))
     {
         m_db = db->newConnector(NEWCONNECTOR_TIMEOUT);
     }
@@ -27,6 +36,18 @@ public:
 
     redisReply *push(const RedisCommand& command, int expectedType)
     {
+        /* Any command is queued, its reply is checked as part of EXEC */
+        countCommand(command);
+
+        if (m_inTransaction)
+        {
+            redisAppendFormattedCommand(m_db->getContext(), command.c_str(), command.length());
+            m_expectedTypes.push(REPLY_QUEUED);
+            m_execTypes.push_back(expectedType);
+            m_remaining++;
+            return NULL;
+        }
+
         switch (expectedType)
         {
             case REDIS_REPLY_NIL:
@@ -48,6 +69,49 @@ public:
         }
     }
 
+    /* Start a transaction. Nothing is sent until exec(), so MULTI, the
+     * commands and EXEC go in one write and their replies are read at the
+     * next flush() */
+    void multi()
+    {
+        if (m_inTransaction)
+        {
+            throw std::runtime_error("MULTI calls can not be nested");
+        }
+
+        RedisCommand command;
+        command.format("MULTI");
+        countCommand(command);
+        redisAppendFormattedCommand(m_db->getContext(), command.c_str(), command.length());
+        m_expectedTypes.push(REDIS_REPLY_STATUS);
+        m_remaining++;
+        m_inTransaction = true;
+    }
+
+    void exec()
+    {
+        if (!m_inTransaction)
+        {
+            throw std::runtime_error("EXEC without MULTI");
+        }
+
+        RedisCommand command;
+        command.format("EXEC");
+        countCommand(command);
+        redisAppendFormattedCommand(m_db->getContext(), command.c_str(), command.length());
+        m_expectedTypes.push(REPLY_EXEC);
+        m_execResults.push(m_execTypes);
+        m_execTypes.clear();
+        m_remaining++;
+        m_inTransaction = false;
+        mayflush();
+    }
+
+    bool inTransaction() const
+    {
+        return m_inTransaction;
+    }
+
     std::string loadRedisScript(const std::string& script)
     {
         RedisCommand loadcmd;
@@ -63,13 +127,36 @@ public:
     {
         if (m_remaining == 0) return NULL;
 
-        redisReply *reply;
-        redisGetReply(m_db->getContext(), (void**)&reply);
+        redisReply *reply = NULL;
+        int status = redisGetReply(m_db->getContext(), (void**)&reply);
         RedisReply r(reply);
         m_remaining--;
 
         int expectedType = m_expectedTypes.front();
         m_expectedTypes.pop();
+
+        if (status != REDIS_OK)
+        {
+            if (expectedType == REPLY_EXEC)
+            {
+                m_execResults.pop();
+            }
+            throw std::runtime_error("Unable to read redis reply");
+        }
+
+        if (expectedType == REPLY_QUEUED)
+        {
+            r.checkReplyType(REDIS_REPLY_STATUS);
+            r.checkStatusQueued();
+            return r.release();
+        }
+
+        if (expectedType == REPLY_EXEC)
+        {
+            checkExec(r);
+            return r.release();
+        }
+
         r.checkReplyType(expectedType);
         if (expectedType == REDIS_REPLY_STATUS)
         {
@@ -80,6 +167,11 @@ public:
 
     void flush()
     {
+        if (m_remaining)
+        {
+            m_flushesMetric.inc();
+        }
+
         while(m_remaining)
         {
             // Construct an object to use its dtor, so that resource is released
@@ -98,10 +190,68 @@ public:
     }
 
 private:
+    /* Expected types of the replies to queued commands and to EXEC */
+    enum
+    {
+        REPLY_QUEUED = -1,
+        REPLY_EXEC = -2
+    };
+
     DBConnector *m_db;
     std::queue<int> m_expectedTypes;
     size_t m_remaining;
 
+    bool m_inTransaction;
+    /* Expected types of the commands queued in the open transaction */
+    std::vector<int> m_execTypes;
+    /* ... and of the transactions waiting for their EXEC reply */
+    std::queue<std::vector<int>> m_execResults;
+
+    void checkExec(RedisReply &r)
+    {
+        std::vector<int> types = m_execResults.front();
+        m_execResults.pop();
+
+        /* EXECABORT if a command was rejected while queued */
+        r.checkReplyType(REDIS_REPLY_ARRAY);
+
+        redisReply *reply = r.getContext();
+        if (reply->elements != types.size())
+        {
+            throw std::runtime_error("Got different number of answers in EXEC");
+        }
+
+        for (size_t i = 0; i < reply->elements; i++)
+        {
+            if (reply->element[i]->type != types[i])
+            {
+                SWSS_LOG_ERROR("Expected to get redis type %d got type %d in EXEC",
+                        types[i], reply->element[i]->type);
+                throw std::runtime_error("Got unexpected result in EXEC");
+            }
+        }
+    }
+
+    Counter &m_commandsMetric;
+    Counter &m_flushesMetric;
+    Counter &m_bytesMetric;
+
+    static MetricsRegistry &getMetrics()
+    {
+        return MetricsRegistry::getInstance();
+    }
+
+    static std::string getMetricName(DBConnector *db, const char *metric)
+    {
+        return "redis_pipeline." + std::to_string(db->getDbId()) + "." + metric;
+    }
+
+    void countCommand(const RedisCommand &command)
+    {
+        m_commandsMetric.inc();
+        m_bytesMetric.inc(command.length());
+    }
+
     void mayflush()
     {
         if (m_remaining >= COMMAND_MAX)
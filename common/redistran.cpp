@@ -1,3 +1,4 @@
+#include <vector>
 #include "redistran.h"
 
 namespace swss {
@@ -15,16 +16,65 @@ RedisTransactioner::~RedisTransactioner()
 void RedisTransactioner::multi()
 {
     m_expectedResults.clear();
-    RedisReply r(m_db, "MULTI", REDIS_REPLY_STATUS);
-    r.checkStatusOK();
+    redisAppendCommand(m_db->getContext(), "MULTI");
 }
 
 /* Execute a transaction and get results */
 bool RedisTransactioner::exec()
+{
+    execAsync();
+    return waitExec();
+}
+
+void RedisTransactioner::execAsync()
 {
     using namespace std;
 
-    RedisReply r(m_db, "EXEC");
+    redisContext *ctx = m_db->getContext();
+    redisAppendCommand(ctx, "EXEC");
+
+    int done = 0;
+    do
+    {
+        if (redisBufferWrite(ctx, &done) != REDIS_OK)
+        {
+            throw system_error(make_error_code(errc::io_error),
+                    "Unable to send transaction");
+        }
+    }
+    while (!done);
+}
+
+bool RedisTransactioner::waitExec()
+{
+    using namespace std;
+
+    /* MULTI, each queued command and EXEC */
+    size_t count = m_expectedResults.size() + 2;
+    vector<unique_ptr<RedisReply>> replies;
+
+    /* Read everything before checking, the connection stays usable */
+    for (size_t i = 0; i < count; i++)
+    {
+        redisReply *reply = nullptr;
+        if (redisGetReply(m_db->getContext(), reinterpret_cast<void**>(&reply)) != REDIS_OK)
+        {
+            throw system_error(make_error_code(errc::io_error),
+                    "Unable to read transaction reply");
+        }
+        replies.emplace_back(new RedisReply(reply));
+    }
+
+    replies.front()->checkReplyType(REDIS_REPLY_STATUS);
+    replies.front()->checkStatusOK();
+
+    for (size_t i = 1; i < count - 1; i++)
+    {
+        replies[i]->checkReplyType(REDIS_REPLY_STATUS);
+        replies[i]->checkStatusQueued();
+    }
+
+    RedisReply &r = *replies.back();
     redisReply *reply = r.getContext();
     size_t size = reply->elements;
 
@@ -65,8 +115,7 @@ bool RedisTransactioner::exec()
 /* Send a command within a transaction */
 void RedisTransactioner::enqueue(const std::string &command, int expectedType)
 {
-    RedisReply r(m_db, command, REDIS_REPLY_STATUS);
-    r.checkStatusQueued();
+    redisAppendCommand(m_db->getContext(), command.c_str());
     m_expectedResults.push_back(expectedType);
 }
 
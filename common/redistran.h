@@ -2,6 +2,7 @@
 
 #include <system_error>
 #include <deque>
+#include <memory>
 #include "redisreply.h"
 #include "rediscommand.h"
 #include "logger.h"
@@ -20,7 +21,14 @@ public:
     /* Execute a transaction and get results */
     bool exec();
 
-    /* Send a command within a transaction */
+    /* Send MULTI, the queued commands and EXEC without waiting for replies,
+     * the connection must not be used for anything else until waitExec() */
+    void execAsync();
+
+    /* Read and check the replies of execAsync(), same result as exec() */
+    bool waitExec();
+
+    /* Queue a command within a transaction, nothing is sent before exec() */
     void enqueue(const std::string &command, int expectedType);
 
     redisReply *dequeueReply();
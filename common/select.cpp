@@ -1,6 +1,7 @@
 #include "common/selectable.h"
 #include "common/logger.h"
 #include "common/select.h"
+#include "common/table.h"
 #include <algorithm>
 #include <stdio.h>
 #include <sys/time.h>
@@ -14,6 +15,9 @@ using namespace std;
 namespace swss {
 
 Select::Select()
+    : m_wakeupsMetric(MetricsRegistry::getInstance().getCounter("select.wakeups"))
+    , m_readyMetric(MetricsRegistry::getInstance().getGauge("select.ready"))
+    , m_lastSelected(NULL)
 {
     m_epoll_fd = ::epoll_create1(0);
     if (m_epoll_fd == -1)
@@ -42,6 +46,11 @@ void Select::addSelectable(Selectable *selectable)
 
     m_objects[fd] = selectable;
 
+    /* Tables are told apart by name, other selectables are aggregated */
+    TableBase *table = dynamic_cast<TableBase *>(selectable);
+    std::string name = table ? table->getTableName() : "other";
+    m_dispatchMetrics[selectable] = &MetricsRegistry::getInstance().getHistogram("select.dispatch_us." + name);
+
     if (selectable->initializedWithData())
     {
         m_ready.insert(selectable);
@@ -68,6 +77,12 @@ void Select::removeSelectable(Selectable *selectable)
 
     m_objects.erase(fd);
     m_ready.erase(selectable);
+    m_dispatchMetrics.erase(selectable);
+
+    if (m_lastSelected == selectable)
+    {
+        m_lastSelected = NULL;
+    }
 
     int res = ::epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, fd, NULL);
     if (res == -1)
@@ -102,6 +117,9 @@ int Select::poll_descriptors(Selectable **c, unsigned int timeout)
     if (ret < 0)
         return Select::ERROR;
 
+    if (ret > 0)
+        m_wakeupsMetric.inc();
+
     for (int i = 0; i < ret; ++i)
     {
         int fd = events[i].data.fd;
@@ -129,18 +147,38 @@ int Select::poll_descriptors(Selectable **c, unsigned int timeout)
 
         sel->updateAfterRead();
 
+        m_readyMetric.set(static_cast<int64_t>(m_ready.size()));
+        m_lastSelected = sel;
+        m_lastSelectedTime = std::chrono::steady_clock::now();
+
         return Select::OBJECT;
     }
 
     return Select::TIMEOUT;
 }
 
+void Select::recordDispatch()
+{
+    if (m_lastSelected == NULL)
+    {
+        return;
+    }
+
+    auto elapsed = std::chrono::steady_clock::now() - m_lastSelectedTime;
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    m_dispatchMetrics[m_lastSelected]->record(static_cast<uint64_t>(us));
+
+    m_lastSelected = NULL;
+}
+
 int Select::select(Selectable **c, unsigned int timeout)
 {
     SWSS_LOG_ENTER();
 
     int ret;
 
+    recordDispatch();
+
     *c = NULL;
     if (timeout == numeric_limits<unsigned int>::max())
         timeout = -1;
@@ -7,8 +7,10 @@
 #include <unordered_map>
 #include <set>
 #include <limits>
+#include <chrono>
 #include <hiredis/hiredis.h>
 #include "selectable.h"
+#include "metrics.h"
 
 namespace swss {
 
@@ -60,9 +62,19 @@ private:
 
     int poll_descriptors(Selectable **c, unsigned int timeout);
 
+    /* Record the time spent on the selectable returned last */
+    void recordDispatch();
+
     int m_epoll_fd;
     std::unordered_map<int, Selectable *> m_objects;
     std::set<Selectable *, Select::cmp> m_ready;
+
+    Counter &m_wakeupsMetric;
+    Gauge &m_readyMetric;
+    /* Time in us between returning a selectable and the next select() */
+    std::unordered_map<Selectable *, Histogram *> m_dispatchMetrics;
+    Selectable *m_lastSelected;
+    std::chrono::time_point<std::chrono::steady_clock> m_lastSelectedTime;
 };
 
 }
@@ -0,0 +1,19 @@
+#include <string>
+#include "dbconnector.h"
+#include "shardedconsumerstatetable.h"
+
+namespace swss {
+
+ShardedConsumerStateTable::ShardedConsumerStateTable(DBConnector *db, const std::string &tableName, int shard,
+                                                     int popBatchSize, int pri)
+    : ConsumerStateTable(db, tableName, shard, popBatchSize, pri)
+    , m_shard(shard)
+{
+}
+
+int ShardedConsumerStateTable::getShard() const
+{
+    return m_shard;
+}
+
+}
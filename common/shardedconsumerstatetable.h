@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string>
+#include "dbconnector.h"
+#include "consumerstatetable.h"
+
+namespace swss {
+
+/*
+ * ConsumerStateTable draining one shard of a table written by a
+ * ShardedProducerStateTable. Each shard needs its own instance and
+ * connection, shards can be drained from different threads.
+ */
+class ShardedConsumerStateTable : public ConsumerStateTable
+{
+public:
+    ShardedConsumerStateTable(DBConnector *db, const std::string &tableName, int shard,
+                              int popBatchSize = DEFAULT_POP_BATCH_SIZE, int pri = 0);
+
+    int getShard() const;
+
+private:
+    int m_shard;
+};
+
+}
@@ -0,0 +1,52 @@
+#include <string>
+#include <stdexcept>
+#include "table.h"
+#include "redispipeline.h"
+#include "shardedproducerstatetable.h"
+
+using namespace std;
+
+namespace swss {
+
+ShardedProducerStateTable::ShardedProducerStateTable(DBConnector *db, const string &tableName, int shards)
+    : ProducerStateTable(db, tableName)
+{
+    initShards(shards);
+}
+
+ShardedProducerStateTable::ShardedProducerStateTable(RedisPipeline *pipeline, const string &tableName, int shards, bool buffered)
+    : ProducerStateTable(pipeline, tableName, buffered)
+{
+    initShards(shards);
+}
+
+ShardedProducerStateTable::~ShardedProducerStateTable()
+{
+    /* While getKeySet() is still ours */
+    writeCoalescedNoThrow();
+}
+
+void ShardedProducerStateTable::initShards(int shards)
+{
+    if (shards <= 0)
+    {
+        throw invalid_argument("Number of shards must be positive");
+    }
+
+    for (int i = 0; i < shards; i++)
+    {
+        m_shards.emplace_back(getTableName(), i);
+    }
+}
+
+int ShardedProducerStateTable::getShardCount() const
+{
+    return static_cast<int>(m_shards.size());
+}
+
+const TableName_KeySet &ShardedProducerStateTable::getKeySet(const string &key) const
+{
+    return m_shards[TableName_KeySet::getShard(key, getShardCount())];
+}
+
+}
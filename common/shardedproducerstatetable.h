@@ -0,0 +1,34 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "table.h"
+#include "redispipeline.h"
+#include "producerstatetable.h"
+
+namespace swss {
+
+/*
+ * ProducerStateTable spreading keys over several key sets and channels, so
+ * that one ShardedConsumerStateTable per shard can drain the table in
+ * parallel. A key always goes to the same shard, which keeps its ordering.
+ */
+class ShardedProducerStateTable : public ProducerStateTable
+{
+public:
+    ShardedProducerStateTable(DBConnector *db, const std::string &tableName, int shards);
+    ShardedProducerStateTable(RedisPipeline *pipeline, const std::string &tableName, int shards, bool buffered = false);
+    ~ShardedProducerStateTable() override;
+
+    int getShardCount() const;
+
+protected:
+    const TableName_KeySet &getKeySet(const std::string &key) const override;
+
+private:
+    void initShards(int shards);
+
+    std::vector<TableName_KeySet> m_shards;
+};
+
+}
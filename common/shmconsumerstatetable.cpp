@@ -0,0 +1,206 @@
+#include <string.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <string>
+#include <deque>
+#include <unordered_set>
+#include <system_error>
+#include "common/logger.h"
+#include "common/redisreply.h"
+#include "common/shmconsumerstatetable.h"
+
+using namespace std;
+
+namespace swss {
+
+ShmConsumerStateTable::ShmConsumerStateTable(DBConnector *db, const string &tableName, int popBatchSize, int pri)
+    : ConsumerStateTable(db, tableName, popBatchSize, pri)
+    , m_ring(to_string(db->getDbId()) + "_" + tableName, ShmRing::CONSUMER)
+    , m_epollFd(-1)
+    , m_keySetPending(m_queueLength > 0)
+{
+    m_epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (m_epollFd == -1)
+    {
+        SWSS_LOG_THROW("failed to create epoll fd, errno: %s", strerror(errno));
+    }
+
+    for (int fd: { RedisSelect::getFd(), m_ring.getFd() })
+    {
+        struct epoll_event ev;
+        memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+
+        if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, fd, &ev) == -1)
+        {
+            close(m_epollFd);
+            SWSS_LOG_THROW("failed to add fd %d to epoll, errno: %s", fd, strerror(errno));
+        }
+    }
+}
+
+ShmConsumerStateTable::~ShmConsumerStateTable()
+{
+    try
+    {
+        detach();
+    }
+    catch (const exception &e)
+    {
+        SWSS_LOG_ERROR("failed to detach from the ring of %s: %s", getTableName().c_str(), e.what());
+    }
+
+    close(m_epollFd);
+}
+
+void ShmConsumerStateTable::detach()
+{
+    m_ring.detach();
+
+    KeyOpFieldsValuesTuple kco;
+    size_t count = 0;
+    while (m_ring.pop(kco))
+    {
+        RedisCommand sadd;
+        sadd.format("SADD %s %s", getKeySetName().c_str(), kfvKey(kco).c_str());
+        RedisReply r(m_db, sadd, REDIS_REPLY_INTEGER);
+        count++;
+    }
+
+    if (count > 0)
+    {
+        RedisCommand publish;
+        publish.format("PUBLISH %s G", getKeySetChannelName().c_str());
+        RedisReply r(m_db, publish, REDIS_REPLY_INTEGER);
+
+        SWSS_LOG_NOTICE("moved %zu unread records of %s to the key set", count, getTableName().c_str());
+    }
+}
+
+int ShmConsumerStateTable::getFd()
+{
+    return m_epollFd;
+}
+
+void ShmConsumerStateTable::readData()
+{
+    struct epoll_event events[2];
+    int ret;
+
+    do
+    {
+        ret = epoll_wait(m_epollFd, events, 2, 0);
+    }
+    while (ret == -1 && errno == EINTR);
+
+    for (int i = 0; i < ret; i++)
+    {
+        if (events[i].data.fd == m_ring.getFd())
+        {
+            m_ring.drainDoorbell();
+        }
+        else
+        {
+            RedisSelect::readData();
+            m_keySetPending = true;
+        }
+    }
+}
+
+bool ShmConsumerStateTable::hasCachedData()
+{
+    return m_buffer.size() > 1 || !m_ring.empty() || m_keySetPending;
+}
+
+bool ShmConsumerStateTable::initializedWithData()
+{
+    return !m_ring.empty() || m_keySetPending;
+}
+
+void ShmConsumerStateTable::updateAfterRead()
+{
+}
+
+void ShmConsumerStateTable::pops(deque<KeyOpFieldsValuesTuple> &vkco, const string &prefix)
+{
+    vkco.clear();
+
+    /* A key written several times is read once, like from the key set */
+    KeyOpFieldsValuesTuple kco;
+    unordered_set<string> keys;
+    while ((int)vkco.size() < POP_BATCH_SIZE && m_ring.pop(kco))
+    {
+        if (keys.insert(kfvKey(kco)).second)
+        {
+            vkco.push_back(kco);
+        }
+    }
+
+    if (!vkco.empty())
+    {
+        readEntries(vkco);
+    }
+
+    if (!vkco.empty() || !m_keySetPending)
+    {
+        countPops(vkco.size());
+        return;
+    }
+
+    ConsumerStateTable::pops(vkco, prefix);
+
+    if ((int)vkco.size() < POP_BATCH_SIZE)
+    {
+        m_keySetPending = false;
+    }
+}
+
+void ShmConsumerStateTable::readEntries(deque<KeyOpFieldsValuesTuple> &vkco)
+{
+    redisContext *ctx = m_db->getContext();
+
+    for (const auto &kco: vkco)
+    {
+        RedisCommand hgetall;
+        hgetall.format("HGETALL %s", getKeyName(kfvKey(kco)).c_str());
+        redisAppendFormattedCommand(ctx, hgetall.c_str(), hgetall.length());
+    }
+
+    /* Read every reply before throwing, the connection must stay in sync */
+    size_t failed = 0;
+    for (auto &kco: vkco)
+    {
+        redisReply *h = nullptr;
+        if (redisGetReply(ctx, reinterpret_cast<void**>(&h)) != REDIS_OK)
+        {
+            throw runtime_error("Unable to read redis reply");
+        }
+
+        RedisReply r(h);
+        auto &values = kfvFieldsValues(kco);
+        values.clear();
+
+        if (h->type != REDIS_REPLY_ARRAY)
+        {
+            SWSS_LOG_ERROR("failed to read %s, reply type %d", getKeyName(kfvKey(kco)).c_str(), h->type);
+            failed++;
+            continue;
+        }
+
+        for (size_t i = 0; i + 1 < h->elements; i += 2)
+        {
+            values.emplace_back(h->element[i]->str, h->element[i + 1]->str);
+        }
+
+        // if there is no field-value pair, the key is already deleted
+        kfvOp(kco) = values.empty() ? DEL_COMMAND : SET_COMMAND;
+    }
+
+    if (failed > 0)
+    {
+        throw runtime_error("failed to read entries of " + getTableName());
+    }
+}
+
+}
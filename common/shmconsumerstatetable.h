@@ -0,0 +1,52 @@
+#pragma once
+
+#include <string>
+#include <deque>
+#include "dbconnector.h"
+#include "consumerstatetable.h"
+#include "shmring.h"
+
+namespace swss {
+
+/*
+ * ConsumerStateTable which also receives entries from a ShmProducerStateTable
+ * through a shared memory ring
+ *
+ * The selectable fd is an epoll fd over both the ring doorbell and the
+ * regular subscription, used by entries which fell back to the key set. The
+ * ring is always drained before the key set. Ring records only name the key,
+ * the entry is read from the table hash, one pipelined round trip per batch.
+ *
+ * Records left in the ring when the consumer is destroyed are moved to the
+ * key set, so that a ConsumerStateTable replacing it gets them.
+ */
+class ShmConsumerStateTable : public ConsumerStateTable
+{
+public:
+    ShmConsumerStateTable(DBConnector *db, const std::string &tableName, int popBatchSize = DEFAULT_POP_BATCH_SIZE, int pri = 0);
+    virtual ~ShmConsumerStateTable();
+
+    /* Get multiple pop elements */
+    void pops(std::deque<KeyOpFieldsValuesTuple> &vkco, const std::string &prefix = EMPTY_PREFIX) override;
+
+    int getFd() override;
+    void readData() override;
+    bool hasCachedData() override;
+    bool initializedWithData() override;
+    void updateAfterRead() override;
+
+private:
+    /* Fill vkco from the table hash of each key */
+    void readEntries(std::deque<KeyOpFieldsValuesTuple> &vkco);
+
+    /* Stop receiving records and move the unread ones to the key set */
+    void detach();
+
+    ShmRing m_ring;
+    int m_epollFd;
+
+    /* Notifications arrived on the subscription since the key set was drained */
+    bool m_keySetPending;
+};
+
+}
@@ -0,0 +1,140 @@
+#include <string>
+#include <vector>
+#include "redisreply.h"
+#include "logger.h"
+#include "table.h"
+#include "redispipeline.h"
+#include "shmproducerstatetable.h"
+
+using namespace std;
+
+namespace swss {
+
+ShmProducerStateTable::ShmProducerStateTable(DBConnector *db, const string &tableName, size_t ringSize)
+    : ProducerStateTable(db, tableName)
+    , m_ring(to_string(db->getDbId()) + "_" + tableName, ShmRing::PRODUCER, ringSize)
+{
+}
+
+ShmProducerStateTable::ShmProducerStateTable(RedisPipeline *pipeline, const string &tableName, bool buffered,
+                                             size_t ringSize)
+    : ProducerStateTable(pipeline, tableName, buffered)
+    , m_ring(to_string(pipeline->getDbId()) + "_" + tableName, ShmRing::PRODUCER, ringSize)
+{
+}
+
+ShmProducerStateTable::~ShmProducerStateTable()
+{
+    try
+    {
+        flush();
+    }
+    catch (const exception &e)
+    {
+        SWSS_LOG_ERROR("Unable to flush the entries of %s: %s", getTableName().c_str(), e.what());
+    }
+}
+
+void ShmProducerStateTable::set(const string &key, const vector<FieldValueTuple> &values,
+                                const string &op, const string &prefix)
+{
+    /* Coalesced and transactional entries go through Redis only */
+    if (m_coalescing || m_pipe->inTransaction())
+    {
+        ProducerStateTable::set(key, values, op, prefix);
+        return;
+    }
+
+    /* Empty set is a notification only, the consumer sees it as a delete */
+    if (!m_ring.isActive() || values.empty())
+    {
+        flush();
+        ProducerStateTable::set(key, values, op, prefix);
+        return;
+    }
+
+    RedisCommand command;
+    command.formatHMSET(getKeyName(key), values);
+    m_pipe->push(command, REDIS_REPLY_STATUS);
+
+    m_pending.push_back(key);
+
+    /* The pipeline flushed on its own, every pending entry is in Redis */
+    if (!m_buffered || m_pipe->size() == 0)
+    {
+        flush();
+    }
+}
+
+void ShmProducerStateTable::del(const string &key, const string &op, const string &prefix)
+{
+    if (!m_ring.isActive() || m_coalescing || m_pipe->inTransaction())
+    {
+        ProducerStateTable::del(key, op, prefix);
+        return;
+    }
+
+    RedisCommand command;
+    command.format("DEL %s", getKeyName(key).c_str());
+    m_pipe->push(command, REDIS_REPLY_INTEGER);
+
+    m_pending.push_back(key);
+
+    if (!m_buffered || m_pipe->size() == 0)
+    {
+        flush();
+    }
+}
+
+void ShmProducerStateTable::flush()
+{
+    ProducerStateTable::flush();
+
+    publishPending();
+}
+
+void ShmProducerStateTable::publishPending()
+{
+    vector<string> reclaimed;
+    m_ring.reclaim(reclaimed);
+    bool fallback = !reclaimed.empty();
+
+    for (const auto &key: reclaimed)
+    {
+        announce(key);
+    }
+
+    KeyOpFieldsValuesTuple kco;
+    for (const auto &key: m_pending)
+    {
+        /* The consumer reads the hash, the record only names the key */
+        kfvKey(kco) = key;
+        if (m_ring.push(kco))
+        {
+            continue;
+        }
+
+        announce(key);
+        fallback = true;
+    }
+
+    m_pending.clear();
+
+    if (fallback)
+    {
+        m_pipe->flush();
+    }
+}
+
+void ShmProducerStateTable::announce(const string &key)
+{
+    RedisCommand sadd;
+    sadd.format("SADD %s %s", getKeySetName().c_str(), key.c_str());
+    m_pipe->push(sadd, REDIS_REPLY_INTEGER);
+
+    RedisCommand publish;
+    publish.format("PUBLISH %s G", getChannelName().c_str());
+    m_pipe->push(publish, REDIS_REPLY_INTEGER);
+}
+
+}
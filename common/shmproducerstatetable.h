@@ -0,0 +1,50 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "producerstatetable.h"
+#include "shmring.h"
+
+namespace swss {
+
+/*
+ * ProducerStateTable which hands entries to a ShmConsumerStateTable on the
+ * same host through a shared memory ring
+ *
+ * The table hash is still written to Redis, before the record is put in the
+ * ring, only the key set and the PUBLISH are skipped. Records only name the
+ * key, the consumer reads the merged hash like ConsumerStateTable does.
+ * Entries fall back to the regular key set path when no consumer is attached
+ * or the ring is full, and so do the records a crashed consumer left behind.
+ */
+class ShmProducerStateTable : public ProducerStateTable
+{
+public:
+    ShmProducerStateTable(DBConnector *db, const std::string &tableName, size_t ringSize = ShmRing::DEFAULT_SIZE);
+    ShmProducerStateTable(RedisPipeline *pipeline, const std::string &tableName, bool buffered = false,
+                          size_t ringSize = ShmRing::DEFAULT_SIZE);
+    virtual ~ShmProducerStateTable();
+
+    void set(const std::string &key,
+             const std::vector<FieldValueTuple> &values,
+             const std::string &op = SET_COMMAND,
+             const std::string &prefix = EMPTY_PREFIX) override;
+
+    void del(const std::string &key,
+             const std::string &op = DEL_COMMAND,
+             const std::string &prefix = EMPTY_PREFIX) override;
+
+    void flush() override;
+
+private:
+    /* Put entries already written to Redis in the ring */
+    void publishPending();
+
+    /* Notify a key the regular way, its hash is already written */
+    void announce(const std::string &key);
+
+    ShmRing m_ring;
+    std::vector<std::string> m_pending;
+};
+
+}
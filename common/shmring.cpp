@@ -0,0 +1,452 @@
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <new>
+#include <system_error>
+
+#include "common/logger.h"
+#include "common/shmring.h"
+
+using namespace std;
+
+namespace swss {
+
+constexpr const char *ShmRing::SHM_RING_DIR;
+constexpr size_t ShmRing::DEFAULT_SIZE;
+
+static const uint64_t SHM_RING_MAGIC = 0x53575353524e4731ULL; // "SWSSRNG1"
+
+ShmRing::ShmRing(const string &name, Role role, size_t size) :
+    m_path(string(SHM_RING_DIR) + "/swss_ring_" + name),
+    m_doorbellPath(m_path + ".sock"),
+    m_role(role),
+    m_active(false),
+    m_fd(-1),
+    m_sock(-1),
+    m_hdr(NULL),
+    m_data(NULL),
+    m_size(0),
+    m_mapSize(0)
+{
+    m_fd = open(m_path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (m_fd == -1)
+    {
+        SWSS_LOG_THROW("failed to open %s, errno: %s", m_path.c_str(), strerror(errno));
+    }
+
+    try
+    {
+        map(size);
+
+        if (!lockRole(m_role))
+        {
+            if (m_role == CONSUMER)
+            {
+                SWSS_LOG_THROW("another consumer is attached to %s", m_path.c_str());
+            }
+
+            SWSS_LOG_NOTICE("another producer owns %s, ring is not used", m_path.c_str());
+            return;
+        }
+
+        m_sock = socket(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (m_sock == -1)
+        {
+            SWSS_LOG_THROW("failed to create doorbell socket, errno: %s", strerror(errno));
+        }
+
+        if (m_role == CONSUMER)
+        {
+            bindDoorbell();
+            m_hdr->consumerAttached = 1;
+        }
+
+        m_active = true;
+    }
+    catch (...)
+    {
+        if (m_sock != -1)
+            close(m_sock);
+        if (m_hdr != NULL)
+            munmap(m_hdr, m_mapSize);
+        close(m_fd);
+        throw;
+    }
+}
+
+ShmRing::~ShmRing()
+{
+    if (m_active && m_role == CONSUMER)
+    {
+        m_hdr->consumerAttached = 0;
+        unlink(m_doorbellPath.c_str());
+    }
+
+    if (m_sock != -1)
+        close(m_sock);
+
+    munmap(m_hdr, m_mapSize);
+
+    /* Also releases the role lock */
+    close(m_fd);
+}
+
+void ShmRing::map(size_t size)
+{
+    /* Whoever comes first creates the ring, the lock serializes both sides */
+    if (flock(m_fd, LOCK_EX) == -1)
+    {
+        SWSS_LOG_THROW("failed to lock %s, errno: %s", m_path.c_str(), strerror(errno));
+    }
+
+    struct stat st;
+    if (fstat(m_fd, &st) == -1)
+    {
+        flock(m_fd, LOCK_UN);
+        SWSS_LOG_THROW("failed to stat %s, errno: %s", m_path.c_str(), strerror(errno));
+    }
+
+    m_mapSize = (size_t)st.st_size;
+    if (m_mapSize == 0)
+    {
+        m_mapSize = sizeof(Header) + size;
+        if (ftruncate(m_fd, (off_t)m_mapSize) == -1)
+        {
+            flock(m_fd, LOCK_UN);
+            SWSS_LOG_THROW("failed to size %s, errno: %s", m_path.c_str(), strerror(errno));
+        }
+    }
+
+    void *addr = mmap(NULL, m_mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    if (addr == MAP_FAILED)
+    {
+        flock(m_fd, LOCK_UN);
+        SWSS_LOG_THROW("failed to map %s, errno: %s", m_path.c_str(), strerror(errno));
+    }
+
+    m_hdr = static_cast<Header *>(addr);
+    m_data = static_cast<uint8_t *>(addr) + sizeof(Header);
+
+    if (m_hdr->magic != SHM_RING_MAGIC)
+    {
+        new (m_hdr) Header();
+        m_hdr->size = m_mapSize - sizeof(Header);
+        m_hdr->consumerAttached = 0;
+        m_hdr->head = 0;
+        m_hdr->tail = 0;
+        m_hdr->magic = SHM_RING_MAGIC;
+    }
+
+    m_size = m_hdr->size;
+
+    flock(m_fd, LOCK_UN);
+}
+
+bool ShmRing::lockRole(Role role)
+{
+    /* Open file description locks are released when the owner dies */
+    struct flock fl;
+    memset(&fl, 0, sizeof(fl));
+    fl.l_type = F_WRLCK;
+    fl.l_whence = SEEK_SET;
+    fl.l_start = (role == PRODUCER) ? 0 : 1;
+    fl.l_len = 1;
+
+    if (fcntl(m_fd, F_OFD_SETLK, &fl) == -1)
+    {
+        if (errno == EAGAIN || errno == EACCES)
+            return false;
+
+        SWSS_LOG_THROW("failed to lock %s, errno: %s", m_path.c_str(), strerror(errno));
+    }
+
+    return true;
+}
+
+void ShmRing::unlockRole(Role role)
+{
+    struct flock fl;
+    memset(&fl, 0, sizeof(fl));
+    fl.l_type = F_UNLCK;
+    fl.l_whence = SEEK_SET;
+    fl.l_start = (role == PRODUCER) ? 0 : 1;
+    fl.l_len = 1;
+
+    if (fcntl(m_fd, F_OFD_SETLK, &fl) == -1)
+    {
+        SWSS_LOG_ERROR("failed to unlock %s, errno: %s", m_path.c_str(), strerror(errno));
+    }
+}
+
+void ShmRing::bindDoorbell()
+{
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+
+    if (m_doorbellPath.size() >= sizeof(addr.sun_path))
+    {
+        SWSS_LOG_THROW("doorbell path %s is too long", m_doorbellPath.c_str());
+    }
+
+    strncpy(addr.sun_path, m_doorbellPath.c_str(), sizeof(addr.sun_path) - 1);
+
+    /* Left over by a consumer which didn't exit cleanly */
+    unlink(m_doorbellPath.c_str());
+
+    if (bind(m_sock, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) == -1)
+    {
+        SWSS_LOG_THROW("failed to bind %s, errno: %s", m_doorbellPath.c_str(), strerror(errno));
+    }
+}
+
+bool ShmRing::isActive() const
+{
+    return m_active;
+}
+
+int ShmRing::getFd() const
+{
+    return m_sock;
+}
+
+bool ShmRing::empty() const
+{
+    return m_hdr->head.load() == m_hdr->tail.load();
+}
+
+void ShmRing::copyIn(uint64_t pos, const void *src, size_t len)
+{
+    size_t off = (size_t)(pos % m_size);
+    size_t first = min(len, m_size - off);
+
+    memcpy(m_data + off, src, first);
+    memcpy(m_data, static_cast<const uint8_t *>(src) + first, len - first);
+}
+
+void ShmRing::copyOut(uint64_t pos, void *dst, size_t len) const
+{
+    size_t off = (size_t)(pos % m_size);
+    size_t first = min(len, m_size - off);
+
+    memcpy(dst, m_data + off, first);
+    memcpy(static_cast<uint8_t *>(dst) + first, m_data, len - first);
+}
+
+static inline void appendString(string &buf, const string &s)
+{
+    uint32_t len = (uint32_t)s.size();
+    buf.append(reinterpret_cast<const char *>(&len), sizeof(len));
+    buf.append(s);
+}
+
+static inline string readString(const string &buf, size_t &pos)
+{
+    uint32_t len;
+
+    if (pos + sizeof(len) > buf.size())
+        throw runtime_error("corrupted shared memory ring record");
+
+    memcpy(&len, buf.data() + pos, sizeof(len));
+    pos += sizeof(len);
+
+    if (pos + len > buf.size())
+        throw runtime_error("corrupted shared memory ring record");
+
+    pos += len;
+    return buf.substr(pos - len, len);
+}
+
+bool ShmRing::push(const KeyOpFieldsValuesTuple &kco)
+{
+    if (!m_active || !m_hdr->consumerAttached)
+    {
+        return false;
+    }
+
+    /* Record is [key, op, field, value, ...] as length prefixed strings */
+    m_record.clear();
+    appendString(m_record, kfvKey(kco));
+    appendString(m_record, kfvOp(kco));
+    for (const auto &fv: kfvFieldsValues(kco))
+    {
+        appendString(m_record, fvField(fv));
+        appendString(m_record, fvValue(fv));
+    }
+
+    uint32_t len = (uint32_t)m_record.size();
+    size_t need = sizeof(len) + len;
+
+    /* Only the producer moves head */
+    uint64_t head = m_hdr->head.load(memory_order_relaxed);
+    uint64_t tail = m_hdr->tail.load(memory_order_acquire);
+
+    if (need > m_size - (size_t)(head - tail))
+    {
+        return false;
+    }
+
+    copyIn(head, &len, sizeof(len));
+    copyIn(head + sizeof(len), m_record.data(), len);
+
+    m_hdr->head.store(head + need);
+
+    /*
+     * The consumer stores tail before checking head, and we store head
+     * before checking tail, so at least one of us sees the other one
+     */
+    if (m_hdr->tail.load() == head)
+    {
+        ring();
+    }
+
+    return true;
+}
+
+uint64_t ShmRing::readRecord(uint64_t tail, uint64_t head, KeyOpFieldsValuesTuple &kco)
+{
+    uint32_t len;
+    copyOut(tail, &len, sizeof(len));
+
+    if (len > head - tail - sizeof(len))
+    {
+        SWSS_LOG_ERROR("corrupted record in %s, len %u", m_path.c_str(), len);
+        throw runtime_error("corrupted shared memory ring record");
+    }
+
+    m_record.resize(len);
+    copyOut(tail + sizeof(len), &m_record[0], len);
+
+    size_t pos = 0;
+    kfvKey(kco) = readString(m_record, pos);
+    kfvOp(kco) = readString(m_record, pos);
+
+    auto &values = kfvFieldsValues(kco);
+    values.clear();
+    while (pos < m_record.size())
+    {
+        string field = readString(m_record, pos);
+        values.emplace_back(field, readString(m_record, pos));
+    }
+
+    return sizeof(len) + len;
+}
+
+bool ShmRing::pop(KeyOpFieldsValuesTuple &kco)
+{
+    /* Only the consumer moves tail */
+    uint64_t tail = m_hdr->tail.load(memory_order_relaxed);
+    uint64_t head = m_hdr->head.load();
+
+    if (head == tail)
+    {
+        return false;
+    }
+
+    m_hdr->tail.store(tail + readRecord(tail, head, kco));
+
+    return true;
+}
+
+void ShmRing::detach()
+{
+    if (m_active && m_role == CONSUMER)
+    {
+        m_hdr->consumerAttached = 0;
+    }
+}
+
+bool ShmRing::reclaim(vector<string> &keys)
+{
+    if (!m_active || m_role != PRODUCER || (!m_hdr->consumerAttached && empty()))
+    {
+        return false;
+    }
+
+    /* Held by a live consumer, holding it also keeps a new one out meanwhile */
+    if (!lockRole(CONSUMER))
+    {
+        return false;
+    }
+
+    uint64_t tail = m_hdr->tail.load();
+    uint64_t head = m_hdr->head.load();
+
+    try
+    {
+        KeyOpFieldsValuesTuple kco;
+        while (tail != head)
+        {
+            tail += readRecord(tail, head, kco);
+            keys.push_back(kfvKey(kco));
+        }
+    }
+    catch (...)
+    {
+        unlockRole(CONSUMER);
+        throw;
+    }
+
+    if (m_hdr->consumerAttached)
+    {
+        SWSS_LOG_NOTICE("consumer of %s is gone, reclaimed %zu records", m_path.c_str(), keys.size());
+    }
+
+    m_hdr->tail.store(head);
+    m_hdr->consumerAttached = 0;
+
+    unlockRole(CONSUMER);
+
+    return true;
+}
+
+void ShmRing::ring()
+{
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, m_doorbellPath.c_str(), sizeof(addr.sun_path) - 1);
+
+    char c = 0;
+    ssize_t s;
+    do
+    {
+        s = sendto(m_sock, &c, sizeof(c), MSG_DONTWAIT | MSG_NOSIGNAL,
+                   reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr));
+    }
+    while (s == -1 && errno == EINTR);
+
+    if (s == -1)
+    {
+        if (errno == ECONNREFUSED || errno == ENOENT)
+        {
+            /* Consumer died without detaching, the record stays for its restart */
+            SWSS_LOG_NOTICE("consumer of %s is gone", m_path.c_str());
+            m_hdr->consumerAttached = 0;
+        }
+        else if (errno != EAGAIN && errno != EWOULDBLOCK)
+        {
+            SWSS_LOG_ERROR("failed to ring %s, errno: %s", m_doorbellPath.c_str(), strerror(errno));
+        }
+    }
+}
+
+void ShmRing::drainDoorbell()
+{
+    char buf[64];
+    ssize_t s;
+
+    do
+    {
+        s = recv(m_sock, buf, sizeof(buf), MSG_DONTWAIT);
+    }
+    while (s > 0 || (s == -1 && errno == EINTR));
+}
+
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <stdint.h>
+#include "table.h"
+
+namespace swss {
+
+/*
+ * Single producer, single consumer ring of KeyOpFieldsValuesTuple records in
+ * shared memory, for tables whose both ends run on the same host.
+ *
+ * The ring is a file in SHM_RING_DIR so it outlives both processes, records
+ * not yet read by a crashed consumer are delivered after its restart, or
+ * handed back to the producer by reclaim() if it restarts without a ring. The
+ * consumer binds a unix datagram socket next to it as a doorbell, its fd is
+ * what the consumer selects on. The producer rings it only when the ring was
+ * empty, and a refused doorbell tells the producer the consumer is gone.
+ */
+class ShmRing
+{
+public:
+    static constexpr const char *SHM_RING_DIR = "/dev/shm";
+    static constexpr size_t DEFAULT_SIZE = 4 * 1024 * 1024;
+
+    enum Role
+    {
+        PRODUCER,
+        CONSUMER
+    };
+
+    /*
+     * Only one producer and one consumer can attach to a ring. A second
+     * producer stays inactive, see isActive(), a second consumer throws.
+     */
+    ShmRing(const std::string &name, Role role, size_t size = DEFAULT_SIZE);
+    ~ShmRing();
+
+    /* false if another producer owns the ring */
+    bool isActive() const;
+
+    /* Producer: false if the record doesn't fit or no consumer is attached */
+    bool push(const KeyOpFieldsValuesTuple &kco);
+
+    /* Consumer: false if the ring is empty */
+    bool pop(KeyOpFieldsValuesTuple &kco);
+
+    /* Consumer: stop receiving records, those already pushed can still be popped */
+    void detach();
+
+    /*
+     * Producer: if the consumer is gone and left records behind, empty the
+     * ring and return the keys of those records, false otherwise
+     */
+    bool reclaim(std::vector<std::string> &keys);
+
+    bool empty() const;
+
+    /* Consumer: doorbell socket */
+    int getFd() const;
+
+    /* Consumer: consume pending doorbell rings */
+    void drainDoorbell();
+
+private:
+    ShmRing(const ShmRing &other);
+    ShmRing& operator = (const ShmRing &other);
+
+    struct Header
+    {
+        uint64_t magic;
+        uint64_t size;
+        std::atomic<uint32_t> consumerAttached;
+
+        /* Written by one side each, keep them on separate cache lines */
+        alignas(64) std::atomic<uint64_t> head;
+        alignas(64) std::atomic<uint64_t> tail;
+    };
+
+    void map(size_t size);
+    bool lockRole(Role role);
+    void unlockRole(Role role);
+    void bindDoorbell();
+    void ring();
+
+    void copyIn(uint64_t pos, const void *src, size_t len);
+    void copyOut(uint64_t pos, void *dst, size_t len) const;
+
+    /* Parse the record at tail, return its size in the ring */
+    uint64_t readRecord(uint64_t tail, uint64_t head, KeyOpFieldsValuesTuple &kco);
+
+    std::string m_path;
+    std::string m_doorbellPath;
+    Role m_role;
+    bool m_active;
+    int m_fd;
+    int m_sock;
+    Header *m_hdr;
+    uint8_t *m_data;
+    size_t m_size;
+    size_t m_mapSize;
+
+    /* Reused serialization buffer */
+    std::string m_record;
+};
+
+}
@@ -94,6 +94,7 @@ void SubscriberStateTable::pops(deque<KeyOpFieldsValuesTuple> &vkco, const strin
     {
         vkco.insert(vkco.end(), m_buffer.begin(), m_buffer.end());
         m_buffer.clear();
+        countPops(vkco.size());
         return;
     }
 
@@ -163,6 +164,7 @@ void SubscriberStateTable::pops(deque<KeyOpFieldsValuesTuple> &vkco, const strin
 
     m_keyspace_event_buffer.clear();
 
+    countPops(vkco.size());
     return;
 }
 
@@ -8,6 +8,7 @@
 #include <utility>
 #include <map>
 #include <deque>
+#include <stdint.h>
 #include "hiredis/hiredis.h"
 #include "dbconnector.h"
 #include "redisreply.h"
@@ -189,15 +190,65 @@ public:
 };
 
 class TableName_KeySet {
-private:
+protected:
     std::string m_key;
+    std::string m_channel;
 public:
     TableName_KeySet(const std::string &tableName)
         : m_key(tableName + "_KEY_SET")
+        , m_channel(tableName + "_CHANNEL")
+    {
+    }
+
+    /* Key set and channel of one shard of a sharded state table */
+    TableName_KeySet(const std::string &tableName, int shard)
+        : m_key(tableName + "_KEY_SET_" + std::to_string(shard))
+        , m_channel(tableName + "_CHANNEL_" + std::to_string(shard))
     {
     }
 
     std::string getKeySetName() const { return m_key; }
+    std::string getKeySetChannelName() const { return m_channel; }
+    /* Hash of the pending trace of each key in the set, see Tracing */
+    std::string getKeySetTraceName() const { return m_key + "_TRACE"; }
+
+    /* Shard of a key, FNV-1a so that every process agrees on it */
+    static int getShard(const std::string &key, int shards)
+    {
+        uint32_t hash = 2166136261U;
+        for (unsigned char c: key)
+        {
+            hash ^= c;
+            hash *= 16777619U;
+        }
+        return static_cast<int>(hash % static_cast<uint32_t>(shards));
+    }
+};
+
+/* Sorted key set, drained in score order */
+class TableName_KeyZSet : public TableName_KeySet {
+public:
+    TableName_KeyZSet(const std::string &tableName)
+        : TableName_KeySet(tableName)
+    {
+        m_key = tableName + "_KEY_ZSET";
+        m_channel = tableName + "_ZSET_CHANNEL";
+    }
+};
+
+class TableName_Stream {
+private:
+    std::string m_stream;
+    std::string m_group;
+public:
+    TableName_Stream(const std::string &tableName)
+        : m_stream(tableName + "_STREAM")
+        , m_group(tableName + "_GROUP")
+    {
+    }
+
+    std::string getStreamName() const { return m_stream; }
+    std::string getStreamGroupName() const { return m_group; }
 };
 
 }
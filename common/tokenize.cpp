@@ -6,30 +6,33 @@ namespace swss {
 
 vector<string> tokenize(const string &str, const char token)
 {
-    string tmp;
     vector<string> ret;
-    istringstream iss(str);
+    Tokenizer tokens(str, token);
+    const char *begin;
+    size_t len;
 
-    while (getline(iss, tmp, token))
-        ret.push_back(tmp);
+    while (tokens.next(begin, len))
+        ret.emplace_back(begin, len);
 
     return ret;
 }
 vector<string> tokenize(const string &str, const char token, const size_t firstN)
 {
     vector<string> ret;
-    string tmp = str;
-    size_t i = 0;
-    auto pos = tmp.find(token);
+    const char *pos = str.data();
+    const char *end = pos + str.size();
 
-    while (pos != string::npos && i++ < firstN)
+    for (size_t i = 0; i < firstN; i++)
     {
-        ret.push_back(tmp.substr(0, pos));
-        tmp = tmp.substr(pos+1);
-        pos = tmp.find(token);
+        auto sep = static_cast<const char *>(memchr(pos, token, static_cast<size_t>(end - pos)));
+        if (sep == nullptr)
+            break;
+
+        ret.emplace_back(pos, sep);
+        pos = sep + 1;
     }
 
-    ret.push_back(tmp);
+    ret.emplace_back(pos, end);
 
     return ret;
 }
@@ -2,13 +2,66 @@
 #define __TOKENIZE__
 
 #include <sstream>
+#include <string>
 #include <vector>
+#include <string.h>
 
 namespace swss {
 
 std::vector<std::string> tokenize(const std::string &, const char token);
 std::vector<std::string> tokenize(const std::string &, const char token, const size_t firstN);
 
+/*
+ * Splits a string on token without copying it: each next() points begin
+ * and len at the following token inside the string, which must outlive
+ * the Tokenizer. The tokens are the ones tokenize() returns.
+ */
+class Tokenizer
+{
+public:
+    Tokenizer(const char *str, size_t len, char token) :
+        m_pos(str),
+        m_end(str + len),
+        m_token(token)
+    {
+    }
+
+    Tokenizer(const std::string &str, char token) :
+        Tokenizer(str.data(), str.size(), token)
+    {
+    }
+
+    /* Returns false once the string is exhausted */
+    inline bool next(const char *&begin, size_t &len)
+    {
+        if (m_pos == m_end)
+        {
+            return false;
+        }
+
+        begin = m_pos;
+
+        auto sep = static_cast<const char *>(memchr(m_pos, m_token, static_cast<size_t>(m_end - m_pos)));
+        if (sep == nullptr)
+        {
+            len = static_cast<size_t>(m_end - m_pos);
+            m_pos = m_end;
+        }
+        else
+        {
+            len = static_cast<size_t>(sep - m_pos);
+            m_pos = sep + 1;
+        }
+
+        return true;
+    }
+
+private:
+    const char *m_pos;
+    const char *m_end;
+    char m_token;
+};
+
 }
 
 #endif /* TOKENIZE */
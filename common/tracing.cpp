@@ -0,0 +1,52 @@
+#include <string>
+#include <atomic>
+#include <time.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include "tracing.h"
+
+using namespace std;
+
+namespace swss {
+
+const char Tracing::OP_SEPARATOR;
+
+static atomic<uint64_t> traceSequence(0);
+
+uint64_t Tracing::now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000ULL + static_cast<uint64_t>(ts.tv_nsec) / 1000ULL;
+}
+
+string Tracing::make()
+{
+    return to_string(now()) + ":" + to_string(getpid()) + "." + to_string(++traceSequence);
+}
+
+bool Tracing::parse(const string &trace, uint64_t &latencyUs, string &traceId)
+{
+    size_t pos = trace.find(':');
+    if (pos == 0 || pos == string::npos)
+    {
+        return false;
+    }
+
+    char *end;
+    uint64_t produced = strtoull(trace.c_str(), &end, 10);
+    if (end != trace.c_str() + pos)
+    {
+        return false;
+    }
+
+    uint64_t consumed = now();
+
+    latencyUs = consumed > produced ? consumed - produced : 0;
+    traceId = trace.substr(pos + 1);
+
+    return true;
+}
+
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <string>
+#include <stdint.h>
+
+namespace swss {
+
+/*
+ * Trace producers attach to entries, holding the monotonic time they were
+ * produced at and a trace id: "<us>:<pid>.<sequence>". It is carried next
+ * to the entry and never written into the table: state tables keep it per
+ * key in the key set's trace hash until the key is popped, ProducerTable
+ * appends it to the queued op after OP_SEPARATOR. Consumer tables record
+ * the produce to consume latency, which is only meaningful with both ends
+ * on the same host.
+ */
+class Tracing
+{
+public:
+    static const char OP_SEPARATOR = '|';
+
+    static std::string make();
+
+    /* Latency since the trace was made and its id, false if malformed */
+    static bool parse(const std::string &trace, uint64_t &latencyUs, std::string &traceId);
+
+    /* Monotonic time in microseconds, the same clock in every process */
+    static uint64_t now();
+};
+
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <stdint.h>
+#include <time.h>
+
+#include "common/histogram.h"
+
+namespace swss {
+namespace bench {
+
+/* Number of operator new calls made by the process, maintained by main.cpp */
+extern std::atomic<uint64_t> g_allocations;
+
+/* Redis server the table benchmarks run against */
+extern std::string g_redisHost;
+extern int g_redisPort;
+
+inline uint64_t now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+/*
+ * State handed to a benchmark function
+ *
+ * The benchmark does its setup, then runs one iteration per next() call:
+ *
+ *     while (state.next())
+ *     {
+ *         ...
+ *     }
+ *
+ * Every iteration is timed individually, so what is recorded includes the
+ * cost of one clock read. Benchmarks whose iteration handles several items
+ * (a batch of pops, a fan-in round) call setItemsPerIteration() and the
+ * throughput and allocations are then reported per item.
+ */
+class State
+{
+public:
+    State(uint64_t minTimeNs, uint64_t maxIterations) :
+        m_minTime(minTimeNs),
+        m_maxIterations(maxIterations),
+        m_iterations(0),
+        m_items(1),
+        m_start(0),
+        m_last(0),
+        m_end(0),
+        m_allocations(0)
+    {
+    }
+
+    inline bool next()
+    {
+        uint64_t t = now();
+
+        if (m_iterations == 0)
+        {
+            m_start = t;
+            m_allocations = g_allocations.load(std::memory_order_relaxed);
+        }
+        else
+        {
+            m_latency.record(t - m_last);
+        }
+
+        if ((m_iterations > 0 && t - m_start >= m_minTime) || m_iterations >= m_maxIterations)
+        {
+            m_end = t;
+            m_allocations = g_allocations.load(std::memory_order_relaxed) - m_allocations;
+            return false;
+        }
+
+        m_iterations++;
+        m_last = now();
+        return true;
+    }
+
+    void setItemsPerIteration(uint64_t items) { m_items = items; }
+
+    /* Marks the benchmark as not run, e.g. when redis is not reachable */
+    void skip(const std::string &reason) { m_skipped = reason; }
+
+    uint64_t getIterations() const { return m_iterations; }
+    uint64_t getItems() const { return m_iterations * m_items; }
+    uint64_t getElapsed() const { return m_end - m_start; }
+    uint64_t getAllocations() const { return m_allocations; }
+    const Histogram &getLatency() const { return m_latency; }
+    const std::string &getSkipped() const { return m_skipped; }
+
+private:
+    uint64_t m_minTime;
+    uint64_t m_maxIterations;
+    uint64_t m_iterations;
+    uint64_t m_items;
+    uint64_t m_start;
+    uint64_t m_last;
+    uint64_t m_end;
+    uint64_t m_allocations;
+    Histogram m_latency;
+    std::string m_skipped;
+};
+
+/* Keeps the compiler from optimizing away the computation of a value */
+template <typename T>
+inline void keep(const T &value)
+{
+    asm volatile("" : : "r"(&value) : "memory");
+}
+
+typedef void (*Function)(State &state);
+
+class Registrar
+{
+public:
+    Registrar(const char *name, Function function);
+};
+
+}
+}
+
+#define SWSS_BENCH(name) \
+    static void bench_##name(swss::bench::State &state); \
+    static swss::bench::Registrar registrar_##name(#name, bench_##name); \
+    static void bench_##name(swss::bench::State &state)
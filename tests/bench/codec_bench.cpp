@@ -0,0 +1,341 @@
+#include <string>
+#include <vector>
+#include <arpa/inet.h>
+
+#include "bench.h"
+#include "common/json.h"
+#include "common/tokenize.h"
+#include "common/ipaddress.h"
+#include "common/ipaddresses.h"
+#include "common/ipprefix.h"
+#include "common/macaddress.h"
+
+using namespace std;
+using namespace swss;
+
+static vector<FieldValueTuple> makeValues(int count)
+{
+    vector<FieldValueTuple> values;
+
+    for (int i = 0; i < count; i++)
+    {
+        values.push_back(FieldValueTuple("field" + to_string(i), "value" + to_string(i)));
+    }
+
+    return values;
+}
+
+SWSS_BENCH(json_build)
+{
+    vector<FieldValueTuple> values = makeValues(16);
+
+    while (state.next())
+    {
+        string json = JSon::buildJson(values);
+        bench::keep(json);
+    }
+}
+
+SWSS_BENCH(json_read)
+{
+    string json = JSon::buildJson(makeValues(16));
+    vector<FieldValueTuple> values;
+
+    while (state.next())
+    {
+        JSon::readJson(json, values);
+        bench::keep(values);
+    }
+}
+
+SWSS_BENCH(tokenize)
+{
+    string key = "PORT_TABLE:Ethernet0:10.0.0.1/31:fc00::1/126";
+
+    while (state.next())
+    {
+        vector<string> tokens = tokenize(key, ':');
+        bench::keep(tokens);
+    }
+}
+
+SWSS_BENCH(tokenize_first_n)
+{
+    string key = "ROUTE_TABLE:fc00::1:2:3:4/64";
+
+    while (state.next())
+    {
+        vector<string> tokens = tokenize(key, ':', 1);
+        bench::keep(tokens);
+    }
+}
+
+SWSS_BENCH(tokenizer)
+{
+    string key = "PORT_TABLE:Ethernet0:10.0.0.1/31:fc00::1/126";
+    const char *begin;
+    size_t len;
+
+    while (state.next())
+    {
+        Tokenizer tokens(key, ':');
+        while (tokens.next(begin, len))
+        {
+            bench::keep(begin);
+        }
+    }
+}
+
+SWSS_BENCH(ipaddresses_parse)
+{
+    string str = "10.0.0.1,10.0.0.2,fc00::1,fc00::2";
+
+    while (state.next())
+    {
+        IpAddresses ips(str);
+        bench::keep(ips);
+    }
+}
+
+SWSS_BENCH(ipv4_parse)
+{
+    string str = "192.168.100.254";
+
+    while (state.next())
+    {
+        IpAddress ip(str);
+        bench::keep(ip);
+    }
+}
+
+SWSS_BENCH(ipv6_parse)
+{
+    string str = "fc00:1234:5678:9abc::def0";
+
+    while (state.next())
+    {
+        IpAddress ip(str);
+        bench::keep(ip);
+    }
+}
+
+SWSS_BENCH(ipv4_format)
+{
+    IpAddress ip("192.168.100.254");
+
+    while (state.next())
+    {
+        string str = ip.to_string();
+        bench::keep(str);
+    }
+}
+
+SWSS_BENCH(ipv6_format)
+{
+    IpAddress ip("fc00:1234:5678:9abc::def0");
+
+    while (state.next())
+    {
+        string str = ip.to_string();
+        bench::keep(str);
+    }
+}
+
+SWSS_BENCH(ipv4_parse_chars)
+{
+    string str = "192.168.100.254";
+    IpAddress ip;
+
+    while (state.next())
+    {
+        IpAddress::parse(str.data(), str.size(), ip);
+        bench::keep(ip);
+    }
+}
+
+SWSS_BENCH(ipv6_parse_chars)
+{
+    string str = "fc00:1234:5678:9abc::def0";
+    IpAddress ip;
+
+    while (state.next())
+    {
+        IpAddress::parse(str.data(), str.size(), ip);
+        bench::keep(ip);
+    }
+}
+
+SWSS_BENCH(ipv6_format_chars)
+{
+    IpAddress ip("fc00:1234:5678:9abc::def0");
+    char buf[IpAddress::MAX_STRING_LEN];
+
+    while (state.next())
+    {
+        char *end = ip.format(buf);
+        bench::keep(end);
+    }
+}
+
+/* What IpAddress used before its own parser and formatter */
+SWSS_BENCH(ipv6_inet_pton)
+{
+    string str = "fc00:1234:5678:9abc::def0";
+    struct in6_addr addr;
+
+    while (state.next())
+    {
+        inet_pton(AF_INET6, str.c_str(), &addr);
+        bench::keep(addr);
+    }
+}
+
+SWSS_BENCH(ipv6_inet_ntop)
+{
+    struct in6_addr addr;
+    inet_pton(AF_INET6, "fc00:1234:5678:9abc::def0", &addr);
+    char buf[INET6_ADDRSTRLEN];
+
+    while (state.next())
+    {
+        const char *str = inet_ntop(AF_INET6, &addr, buf, sizeof(buf));
+        bench::keep(str);
+    }
+}
+
+SWSS_BENCH(ipprefix_parse)
+{
+    string str = "10.128.0.0/9";
+
+    while (state.next())
+    {
+        IpPrefix prefix(str);
+        bench::keep(prefix);
+    }
+}
+
+SWSS_BENCH(ipprefix_parse_chars)
+{
+    string str = "fc00:1234:5678::/48";
+    IpPrefix prefix;
+
+    while (state.next())
+    {
+        IpPrefix::parse(str.data(), str.size(), prefix);
+        bench::keep(prefix);
+    }
+}
+
+SWSS_BENCH(ipv6_subnet)
+{
+    IpPrefix prefix("fc00:1234:5678:9abc::def0/48");
+
+    while (state.next())
+    {
+        IpPrefix subnet = prefix.getSubnet();
+        bench::keep(subnet);
+    }
+}
+
+SWSS_BENCH(ipv4_in_subnet)
+{
+    IpPrefix prefix("10.128.0.0/9");
+    IpAddress ip("10.200.1.1");
+
+    while (state.next())
+    {
+        bool in = prefix.isAddressInSubnet(ip);
+        bench::keep(in);
+    }
+}
+
+SWSS_BENCH(ipv6_in_subnet)
+{
+    IpPrefix prefix("fc00:1234:5678::/48");
+    IpAddress ip("fc00:1234:5678:9abc::def0");
+
+    while (state.next())
+    {
+        bool in = prefix.isAddressInSubnet(ip);
+        bench::keep(in);
+    }
+}
+
+SWSS_BENCH(mac_parse)
+{
+    string str = "00:11:22:aa:bb:cc";
+
+    while (state.next())
+    {
+        MacAddress mac(str);
+        bench::keep(mac);
+    }
+}
+
+SWSS_BENCH(mac_format)
+{
+    MacAddress mac("00:11:22:aa:bb:cc");
+
+    while (state.next())
+    {
+        string str = mac.to_string();
+        bench::keep(str);
+    }
+}
+
+#define MAC_BATCH   (1024)
+
+static vector<MacAddress> macBatch()
+{
+    vector<MacAddress> macs;
+
+    for (int i = 0; i < MAC_BATCH; i++)
+    {
+        uint8_t mac[ETHER_ADDR_LEN] = { 0x00, 0x11, 0x22, 0x00, 0x00, 0x00 };
+        mac[3] = static_cast<uint8_t>(i * 7);
+        mac[4] = static_cast<uint8_t>(i >> 8);
+        mac[5] = static_cast<uint8_t>(i);
+        macs.push_back(MacAddress(mac));
+    }
+
+    return macs;
+}
+
+SWSS_BENCH(mac_parse_batch)
+{
+    vector<string> strs;
+    vector<const char *> ptrs;
+    vector<size_t> lens;
+
+    for (const auto &mac : macBatch())
+    {
+        strs.push_back(mac.to_string());
+    }
+    for (const auto &s : strs)
+    {
+        ptrs.push_back(s.data());
+        lens.push_back(s.size());
+    }
+
+    vector<MacAddress> macs(MAC_BATCH);
+    state.setItemsPerIteration(MAC_BATCH);
+
+    while (state.next())
+    {
+        size_t parsed = MacAddress::parse(ptrs.data(), lens.data(), MAC_BATCH, macs.data());
+        bench::keep(parsed);
+    }
+}
+
+SWSS_BENCH(mac_format_batch)
+{
+    vector<MacAddress> macs = macBatch();
+    vector<char> buf(MAC_BATCH * MacAddress::STRING_LEN);
+    state.setItemsPerIteration(MAC_BATCH);
+
+    while (state.next())
+    {
+        char *end = MacAddress::format(macs.data(), MAC_BATCH, buf.data());
+        bench::keep(end);
+    }
+}
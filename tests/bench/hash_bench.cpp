@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <map>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "bench.h"
+#include "common/flathashmap.h"
+#include "common/ipaddress.h"
+#include "common/macaddress.h"
+
+using namespace std;
+using namespace swss;
+
+/* An FDB or neighbor table of a large switch */
+#define ENTRIES     (200000)
+
+static vector<MacAddress> macs()
+{
+    mt19937 gen(1);
+    vector<MacAddress> v;
+
+    for (int i = 0; i < ENTRIES; i++)
+    {
+        uint8_t mac[ETHER_ADDR_LEN];
+        for (int j = 0; j < ETHER_ADDR_LEN; j++)
+        {
+            mac[j] = static_cast<uint8_t>(gen());
+        }
+        v.push_back(MacAddress(mac));
+    }
+
+    return v;
+}
+
+static vector<IpAddress> neighbors()
+{
+    mt19937 gen(1);
+    vector<IpAddress> v;
+
+    for (int i = 0; i < ENTRIES; i++)
+    {
+        ip_addr_t ip;
+        ip.family = AF_INET6;
+        for (int j = 0; j < 16; j++)
+        {
+            ip.ip_addr.ipv6_addr[j] = static_cast<uint8_t>(j < 8 ? 0x20 + j : gen());
+        }
+        v.push_back(IpAddress(ip));
+    }
+
+    return v;
+}
+
+template <typename Map, typename Key>
+static void lookup(bench::State &state, const vector<Key> &keys)
+{
+    Map map;
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        map[keys[i]] = static_cast<uint32_t>(i);
+    }
+
+    /* Look up in an order unrelated to the insertion one */
+    vector<size_t> order(keys.size());
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        order[i] = i;
+    }
+    shuffle(order.begin(), order.end(), mt19937(2));
+
+    size_t i = 0;
+    while (state.next())
+    {
+        uint32_t &value = map[keys[order[i++ % order.size()]]];
+        bench::keep(value);
+    }
+}
+
+template <typename Map, typename Key>
+static void build(bench::State &state, const vector<Key> &keys)
+{
+    state.setItemsPerIteration(keys.size());
+
+    while (state.next())
+    {
+        Map map;
+        for (size_t i = 0; i < keys.size(); i++)
+        {
+            map[keys[i]] = static_cast<uint32_t>(i);
+        }
+        bench::keep(map);
+    }
+}
+
+SWSS_BENCH(mac_lookup_flat_hash_map)
+{
+    lookup<FlatHashMap<MacAddress, uint32_t>>(state, macs());
+}
+
+SWSS_BENCH(mac_lookup_unordered_map)
+{
+    lookup<unordered_map<MacAddress, uint32_t>>(state, macs());
+}
+
+SWSS_BENCH(mac_lookup_map)
+{
+    lookup<map<MacAddress, uint32_t>>(state, macs());
+}
+
+SWSS_BENCH(ipv6_lookup_flat_hash_map)
+{
+    lookup<FlatHashMap<IpAddress, uint32_t>>(state, neighbors());
+}
+
+SWSS_BENCH(ipv6_lookup_unordered_map)
+{
+    lookup<unordered_map<IpAddress, uint32_t>>(state, neighbors());
+}
+
+SWSS_BENCH(ipv6_lookup_map)
+{
+    lookup<map<IpAddress, uint32_t>>(state, neighbors());
+}
+
+SWSS_BENCH(mac_build_flat_hash_map)
+{
+    build<FlatHashMap<MacAddress, uint32_t>>(state, macs());
+}
+
+SWSS_BENCH(mac_build_unordered_map)
+{
+    build<unordered_map<MacAddress, uint32_t>>(state, macs());
+}
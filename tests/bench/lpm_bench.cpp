@@ -0,0 +1,189 @@
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "bench.h"
+#include "common/ipprefixtrie.h"
+
+using namespace std;
+using namespace swss;
+
+/* Roughly the size of the full Internet routing tables */
+#define V4_PREFIXES     (1000000)
+#define V6_PREFIXES     (200000)
+#define ADDRESSES       (65536)
+
+typedef vector<pair<IpPrefix, uint32_t>> Entries;
+
+/* Prefix length distribution of the tables, most routes are /24 and /48 */
+static int v4Length(mt19937 &gen)
+{
+    uint32_t r = static_cast<uint32_t>(gen() % 100);
+    return r < 60 ? 24 : r < 70 ? 22 : r < 80 ? 23 : r < 90 ? 20 : 8 + static_cast<int>(gen() % 24);
+}
+
+static int v6Length(mt19937 &gen)
+{
+    uint32_t r = static_cast<uint32_t>(gen() % 100);
+    return r < 50 ? 48 : r < 65 ? 32 : r < 75 ? 44 : r < 85 ? 40 : r < 90 ? 64 : 16 + static_cast<int>(gen() % 113);
+}
+
+static IpAddress randomAddress(mt19937 &gen, bool v4)
+{
+    if (v4)
+    {
+        return IpAddress(static_cast<uint32_t>(gen()));
+    }
+
+    ip_addr_t ip;
+    ip.family = AF_INET6;
+    /* Global unicast 2000::/3 */
+    for (int i = 0; i < 16; i += 4)
+    {
+        uint32_t r = static_cast<uint32_t>(gen());
+        memcpy(ip.ip_addr.ipv6_addr + i, &r, 4);
+    }
+    ip.ip_addr.ipv6_addr[0] = static_cast<unsigned char>(0x20 | (ip.ip_addr.ipv6_addr[0] & 0x1f));
+    return IpAddress(ip);
+}
+
+static const Entries &entries(bool v4)
+{
+    static Entries v4Entries, v6Entries;
+    Entries &e = v4 ? v4Entries : v6Entries;
+
+    if (e.empty())
+    {
+        mt19937 gen(v4 ? 4 : 6);
+        int count = v4 ? V4_PREFIXES : V6_PREFIXES;
+
+        for (int i = 0; i < count; i++)
+        {
+            IpPrefix p(randomAddress(gen, v4), v4 ? v4Length(gen) : v6Length(gen));
+            e.push_back(make_pair(p.getSubnet(), static_cast<uint32_t>(i)));
+        }
+    }
+
+    return e;
+}
+
+static const IpPrefixTrie<uint32_t> &table(bool v4)
+{
+    static IpPrefixTrie<uint32_t> v4Table, v6Table;
+    IpPrefixTrie<uint32_t> &t = v4 ? v4Table : v6Table;
+
+    if (t.empty())
+    {
+        t.build(entries(v4));
+    }
+
+    return t;
+}
+
+static vector<IpAddress> addresses(bool v4)
+{
+    mt19937 gen(42);
+    vector<IpAddress> addrs;
+
+    for (int i = 0; i < ADDRESSES; i++)
+    {
+        addrs.push_back(randomAddress(gen, v4));
+    }
+
+    return addrs;
+}
+
+static void build(bench::State &state, bool v4)
+{
+    const Entries &e = entries(v4);
+
+    state.setItemsPerIteration(e.size());
+
+    while (state.next())
+    {
+        IpPrefixTrie<uint32_t> t;
+        t.build(e);
+        bench::keep(t);
+    }
+}
+
+static void lookup(bench::State &state, bool v4)
+{
+    const IpPrefixTrie<uint32_t> &t = table(v4);
+    vector<IpAddress> addrs = addresses(v4);
+    size_t i = 0;
+
+    while (state.next())
+    {
+        const uint32_t *value = t.lookup(addrs[i++ % ADDRESSES]);
+        bench::keep(value);
+    }
+}
+
+SWSS_BENCH(lpm_v4_build_1m)
+{
+    build(state, true);
+}
+
+SWSS_BENCH(lpm_v4_lookup_1m)
+{
+    lookup(state, true);
+}
+
+SWSS_BENCH(lpm_v6_build_200k)
+{
+    build(state, false);
+}
+
+SWSS_BENCH(lpm_v6_lookup_200k)
+{
+    lookup(state, false);
+}
+
+SWSS_BENCH(lpm_v4_remove_insert_1m)
+{
+    IpPrefixTrie<uint32_t> t;
+    const Entries &e = entries(true);
+    t.build(e);
+    size_t i = 0;
+
+    state.setItemsPerIteration(2);
+
+    while (state.next())
+    {
+        const auto &entry = e[i++ % e.size()];
+        t.remove(entry.first);
+        t.insert(entry.first, entry.second);
+    }
+}
+
+/* What IpPrefix::isAddressInSubnet() offers without the trie */
+SWSS_BENCH(linear_scan_v4_1k)
+{
+    set<IpPrefix> prefixes;
+    const Entries &e = entries(true);
+    for (size_t j = 0; j < 1000; j++)
+    {
+        prefixes.insert(e[j].first);
+    }
+
+    vector<IpAddress> addrs = addresses(true);
+    size_t i = 0;
+
+    while (state.next())
+    {
+        const IpAddress &addr = addrs[i++ % ADDRESSES];
+        const IpPrefix *best = nullptr;
+
+        for (const auto &p : prefixes)
+        {
+            if (p.isAddressInSubnet(addr) && (!best || p.getMaskLength() > best->getMaskLength()))
+            {
+                best = &p;
+            }
+        }
+
+        bench::keep(best);
+    }
+}
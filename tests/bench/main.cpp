@@ -0,0 +1,167 @@
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+#include <utility>
+#include <getopt.h>
+
+#include "bench.h"
+
+using namespace std;
+
+namespace swss {
+namespace bench {
+
+atomic<uint64_t> g_allocations(0);
+
+string g_redisHost = "localhost";
+int g_redisPort = 6379;
+
+static vector<pair<string, Function>> &benchmarks()
+{
+    static vector<pair<string, Function>> registered;
+    return registered;
+}
+
+Registrar::Registrar(const char *name, Function function)
+{
+    benchmarks().push_back(make_pair(string(name), function));
+}
+
+}
+}
+
+using namespace swss::bench;
+
+void *operator new(size_t size)
+{
+    g_allocations.fetch_add(1, memory_order_relaxed);
+
+    void *p = malloc(size ? size : 1);
+    if (!p)
+    {
+        throw bad_alloc();
+    }
+
+    return p;
+}
+
+void *operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void *p) noexcept
+{
+    free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+    free(p);
+}
+
+static void usage()
+{
+    printf("Usage: swssbench [-f FILTER] [-t SECONDS] [-n ITERATIONS] [-H HOST] [-p PORT] [-l]\n"
+           "  -f  run only the benchmarks whose name contains FILTER\n"
+           "  -t  minimum run time of each benchmark (default 1)\n"
+           "  -n  maximum iterations of each benchmark\n"
+           "  -H  redis host the table benchmarks use (default localhost)\n"
+           "  -p  redis port (default 6379)\n"
+           "  -l  list the benchmarks and exit\n"
+           "\n"
+           "Latencies are per iteration, throughput and allocations per item.\n"
+           "Allocations count operator new calls only.\n"
+           "The table benchmarks write BENCH_* tables in database 15, the one\n"
+           "the functional tests use.\n");
+}
+
+int main(int argc, char **argv)
+{
+    string filter;
+    double seconds = 1;
+    uint64_t maxIterations = UINT64_MAX;
+    bool list = false;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "f:t:n:H:p:lh")) != -1)
+    {
+        switch (opt)
+        {
+        case 'f':
+            filter = optarg;
+            break;
+        case 't':
+            seconds = atof(optarg);
+            break;
+        case 'n':
+            maxIterations = strtoull(optarg, NULL, 0);
+            break;
+        case 'H':
+            g_redisHost = optarg;
+            break;
+        case 'p':
+            g_redisPort = atoi(optarg);
+            break;
+        case 'l':
+            list = true;
+            break;
+        default:
+            usage();
+            return opt == 'h' ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    if (!list)
+    {
+        printf("%-40s %12s %14s %12s %12s %10s\n",
+               "benchmark", "iterations", "items/s", "p50 ns", "p99 ns", "allocs");
+    }
+
+    for (const auto &b : benchmarks())
+    {
+        if (b.first.find(filter) == string::npos)
+        {
+            continue;
+        }
+
+        if (list)
+        {
+            printf("%s\n", b.first.c_str());
+            continue;
+        }
+
+        State state(static_cast<uint64_t>(seconds * 1e9), maxIterations);
+        try
+        {
+            b.second(state);
+        }
+        catch (const exception &e)
+        {
+            printf("%-40s failed: %s\n", b.first.c_str(), e.what());
+            continue;
+        }
+
+        if (!state.getSkipped().empty())
+        {
+            printf("%-40s skipped: %s\n", b.first.c_str(), state.getSkipped().c_str());
+            continue;
+        }
+
+        double elapsed = static_cast<double>(state.getElapsed()) / 1e9;
+        double items = static_cast<double>(state.getItems());
+
+        printf("%-40s %12llu %14.0f %12llu %12llu %10.2f\n",
+               b.first.c_str(),
+               static_cast<unsigned long long>(state.getIterations()),
+               elapsed > 0 ? items / elapsed : 0,
+               static_cast<unsigned long long>(state.getLatency().getPercentile(50)),
+               static_cast<unsigned long long>(state.getLatency().getPercentile(99)),
+               items > 0 ? static_cast<double>(state.getAllocations()) / items : 0);
+        fflush(stdout);
+    }
+
+    return EXIT_SUCCESS;
+}
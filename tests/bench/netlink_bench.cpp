@@ -0,0 +1,370 @@
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <string>
+#include <vector>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <linux/if.h>
+#include <netlink/msg.h>
+#include <netlink/attr.h>
+
+#include "bench.h"
+#include "common/netdispatcher.h"
+#include "common/rawnetdispatcher.h"
+#include "common/linkcache.h"
+
+using namespace std;
+using namespace swss;
+
+/*
+ * Netlink messages are replayed from a buffer of raw nlmsghdr, as read from
+ * a NETLINK_ROUTE socket. SWSS_BENCH_NETLINK_DUMP names a file holding such
+ * a recording, e.g. taken during a route churn, otherwise the link, address
+ * and route dumps of the host are recorded at startup.
+ */
+#define STORM_LINKS     (256)
+#define STORM_FLAPS     (32)
+
+typedef vector<char> Dump;
+
+static void append(Dump &dump, const struct nlmsghdr *hdr)
+{
+    const char *p = reinterpret_cast<const char *>(hdr);
+    dump.insert(dump.end(), p, p + NLMSG_ALIGN(hdr->nlmsg_len));
+}
+
+static void recordDump(Dump &dump, uint16_t rtmType)
+{
+    int fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+    if (fd < 0)
+    {
+        return;
+    }
+
+    struct
+    {
+        struct nlmsghdr hdr;
+        struct rtgenmsg gen;
+    } req = {};
+
+    req.hdr.nlmsg_len = sizeof(req);
+    req.hdr.nlmsg_type = rtmType;
+    req.hdr.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    req.hdr.nlmsg_seq = 1;
+    req.gen.rtgen_family = AF_UNSPEC;
+
+    if (send(fd, &req, sizeof(req), 0) == sizeof(req))
+    {
+        static char buf[65536];
+        bool done = false;
+
+        while (!done)
+        {
+            ssize_t n = recv(fd, buf, sizeof(buf), 0);
+            if (n <= 0)
+            {
+                break;
+            }
+
+            for (size_t off = 0; off + sizeof(struct nlmsghdr) <= static_cast<size_t>(n); )
+            {
+                auto hdr = reinterpret_cast<const struct nlmsghdr *>(buf + off);
+                if (hdr->nlmsg_len < sizeof(struct nlmsghdr) || off + hdr->nlmsg_len > static_cast<size_t>(n) ||
+                    hdr->nlmsg_type == NLMSG_DONE || hdr->nlmsg_type == NLMSG_ERROR)
+                {
+                    done = true;
+                    break;
+                }
+
+                append(dump, hdr);
+                off += NLMSG_ALIGN(hdr->nlmsg_len);
+            }
+        }
+    }
+
+    close(fd);
+}
+
+static const Dump &recordedDump()
+{
+    static Dump dump;
+    static bool loaded = false;
+
+    if (!loaded)
+    {
+        loaded = true;
+
+        const char *path = getenv("SWSS_BENCH_NETLINK_DUMP");
+        if (path)
+        {
+            ifstream in(path, ios::binary);
+            dump.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+        }
+        else
+        {
+            recordDump(dump, RTM_GETLINK);
+            recordDump(dump, RTM_GETADDR);
+            recordDump(dump, RTM_GETROUTE);
+        }
+    }
+
+    return dump;
+}
+
+/* Every link going down and up STORM_FLAPS times, interleaved */
+static const Dump &linkStorm()
+{
+    static Dump dump;
+
+    if (dump.empty())
+    {
+        for (int flap = 0; flap < STORM_FLAPS; flap++)
+        {
+            for (int i = 0; i < STORM_LINKS; i++)
+            {
+                struct ifinfomsg ifi = {};
+                ifi.ifi_family = AF_UNSPEC;
+                ifi.ifi_index = 100 + i;
+                ifi.ifi_flags = flap % 2 ? IFF_UP | IFF_RUNNING : IFF_UP;
+
+                string name = "Ethernet" + to_string(i * 4);
+                struct nl_msg *msg = nlmsg_alloc_simple(RTM_NEWLINK, 0);
+                nlmsg_append(msg, &ifi, sizeof(ifi), NLMSG_ALIGNTO);
+                nla_put_string(msg, IFLA_IFNAME, name.c_str());
+                nla_put_u32(msg, IFLA_MTU, 9100);
+                nla_put_u8(msg, IFLA_OPERSTATE, flap % 2 ? IF_OPER_UP : IF_OPER_DOWN);
+                append(dump, nlmsg_hdr(msg));
+                nlmsg_free(msg);
+            }
+        }
+    }
+
+    return dump;
+}
+
+class CountingHandler : public NetMsg, public NetBatchMsg
+{
+public:
+    void onMsg(int, struct nl_object *obj) override
+    {
+        bench::keep(obj);
+        count++;
+    }
+
+    void onMsgBatch(int, const vector<struct nl_object *> &objs) override
+    {
+        count += objs.size();
+    }
+
+    size_t count = 0;
+};
+
+/* Reads the attributes a route, address or link handler typically needs */
+class RawParsingHandler : public RawNetMsg
+{
+public:
+    void onMsg(const struct nlmsghdr *msg) override
+    {
+        switch (msg->nlmsg_type)
+        {
+            case RTM_NEWLINK:
+            case RTM_DELLINK:
+            {
+                auto attrs = NetlinkAttrs<IFLA_MAX>::parse<struct ifinfomsg>(msg);
+                bench::keep(attrs.getString(IFLA_IFNAME));
+                bench::keep(attrs.getValue<uint32_t>(IFLA_MTU));
+                bench::keep(attrs.getValue<uint8_t>(IFLA_OPERSTATE));
+                break;
+            }
+            case RTM_NEWADDR:
+            case RTM_DELADDR:
+            {
+                auto attrs = NetlinkAttrs<IFA_MAX>::parse<struct ifaddrmsg>(msg);
+                bench::keep(attrs.get(IFA_ADDRESS));
+                break;
+            }
+            case RTM_NEWROUTE:
+            case RTM_DELROUTE:
+            {
+                auto attrs = NetlinkAttrs<RTA_MAX>::parse<struct rtmsg>(msg);
+                bench::keep(attrs.get(RTA_DST));
+                bench::keep(attrs.getValue<uint32_t>(RTA_OIF));
+                bench::keep(attrs.get(RTA_MULTIPATH));
+                break;
+            }
+            default:
+                break;
+        }
+
+        count++;
+    }
+
+    size_t count = 0;
+};
+
+/* Handlers for every message type in a dump, removed when leaving the benchmark */
+class Registration
+{
+public:
+    Registration(const Dump &dump, CountingHandler &handler, bool batched)
+    {
+        forEach(dump, [&](struct nlmsghdr *hdr) { m_types.insert(hdr->nlmsg_type); });
+
+        for (int type : m_types)
+        {
+            if (batched)
+            {
+                NetDispatcher::getInstance().registerBatchHandler(type, &handler);
+            }
+            else
+            {
+                NetDispatcher::getInstance().registerMessageHandler(type, &handler);
+            }
+        }
+    }
+
+    ~Registration()
+    {
+        NetDispatcher::getInstance().flush();
+        for (int type : m_types)
+        {
+            NetDispatcher::getInstance().unregisterMessageHandler(type);
+        }
+    }
+
+    template <typename F>
+    static size_t forEach(const Dump &dump, F f)
+    {
+        size_t count = 0;
+
+        for (size_t off = 0; off + sizeof(struct nlmsghdr) <= dump.size(); count++)
+        {
+            auto hdr = reinterpret_cast<struct nlmsghdr *>(const_cast<char *>(dump.data() + off));
+            f(hdr);
+            off += NLMSG_ALIGN(hdr->nlmsg_len);
+        }
+
+        return count;
+    }
+
+private:
+    set<int> m_types;
+};
+
+static void replay(bench::State &state, const Dump &dump, bool batched)
+{
+    if (dump.empty())
+    {
+        state.skip("no netlink messages recorded");
+        return;
+    }
+
+    CountingHandler handler;
+    Registration registration(dump, handler, batched);
+    NetDispatcher &dispatcher = NetDispatcher::getInstance();
+
+    state.setItemsPerIteration(Registration::forEach(dump, [](struct nlmsghdr *) {}));
+
+    while (state.next())
+    {
+        /* What NetLink::readData() does for each message it receives */
+        Registration::forEach(dump, [&](struct nlmsghdr *hdr) {
+            struct nl_msg *msg = nlmsg_convert(hdr);
+            nlmsg_set_proto(msg, NETLINK_ROUTE);
+            dispatcher.onNetlinkMessage(msg);
+            nlmsg_free(msg);
+        });
+        dispatcher.flush();
+    }
+
+    bench::keep(handler.count);
+}
+
+static void replayRaw(bench::State &state, const Dump &dump)
+{
+    if (dump.empty())
+    {
+        state.skip("no netlink messages recorded");
+        return;
+    }
+
+    RawParsingHandler handler;
+    RawNetDispatcher &dispatcher = RawNetDispatcher::getInstance();
+    set<uint16_t> types;
+
+    Registration::forEach(dump, [&](struct nlmsghdr *hdr) { types.insert(hdr->nlmsg_type); });
+    for (auto type : types)
+    {
+        dispatcher.registerMessageHandler(type, &handler);
+    }
+
+    state.setItemsPerIteration(Registration::forEach(dump, [](struct nlmsghdr *) {}));
+
+    while (state.next())
+    {
+        dispatcher.onNetlinkMessages(dump.data(), dump.size());
+    }
+
+    for (auto type : types)
+    {
+        dispatcher.unregisterMessageHandler(type);
+    }
+
+    bench::keep(handler.count);
+}
+
+SWSS_BENCH(netlink_link_storm)
+{
+    replay(state, linkStorm(), false);
+}
+
+SWSS_BENCH(netlink_link_storm_batched)
+{
+    replay(state, linkStorm(), true);
+}
+
+SWSS_BENCH(netlink_link_storm_raw)
+{
+    replayRaw(state, linkStorm());
+}
+
+SWSS_BENCH(netlink_dump_replay)
+{
+    replay(state, recordedDump(), false);
+}
+
+SWSS_BENCH(netlink_dump_replay_batched)
+{
+    replay(state, recordedDump(), true);
+}
+
+SWSS_BENCH(netlink_dump_replay_raw)
+{
+    replayRaw(state, recordedDump());
+}
+
+SWSS_BENCH(linkcache_hit)
+{
+    LinkCache &cache = LinkCache::getInstance();
+
+    /* The loopback, first link of every network namespace */
+    while (state.next())
+    {
+        string name = cache.ifindexToName(1);
+        bench::keep(name);
+    }
+}
+
+/* An index no link has, answered from the negative entry after the first miss */
+SWSS_BENCH(linkcache_miss)
+{
+    LinkCache &cache = LinkCache::getInstance();
+
+    while (state.next())
+    {
+        string name = cache.ifindexToName(60000);
+        bench::keep(name);
+    }
+}
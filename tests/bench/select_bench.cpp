@@ -0,0 +1,56 @@
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "bench.h"
+#include "common/select.h"
+#include "common/selectableevent.h"
+
+using namespace std;
+using namespace swss;
+
+static void fanIn(bench::State &state, int sources)
+{
+    Select s;
+    vector<unique_ptr<SelectableEvent>> events;
+
+    for (int i = 0; i < sources; i++)
+    {
+        events.emplace_back(new SelectableEvent());
+        s.addSelectable(events.back().get());
+    }
+
+    state.setItemsPerIteration(static_cast<uint64_t>(sources));
+
+    while (state.next())
+    {
+        for (auto &e : events)
+        {
+            e->notify();
+        }
+
+        for (int i = 0; i < sources; i++)
+        {
+            Selectable *sel;
+            if (s.select(&sel, 1000) != Select::OBJECT)
+            {
+                throw runtime_error("select did not return an event");
+            }
+        }
+    }
+}
+
+SWSS_BENCH(select_fanin_1)
+{
+    fanIn(state, 1);
+}
+
+SWSS_BENCH(select_fanin_16)
+{
+    fanIn(state, 16);
+}
+
+SWSS_BENCH(select_fanin_256)
+{
+    fanIn(state, 256);
+}
@@ -0,0 +1,287 @@
+#include <deque>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "bench.h"
+#include "common/dbconnector.h"
+#include "common/redispipeline.h"
+#include "common/redisreply.h"
+#include "common/table.h"
+#include "common/producertable.h"
+#include "common/consumertable.h"
+#include "common/producerstatetable.h"
+#include "common/consumerstatetable.h"
+#include "common/notificationproducer.h"
+#include "common/notificationconsumer.h"
+#include "common/select.h"
+
+using namespace std;
+using namespace swss;
+
+#define BENCH_DB            (15) // Same as the functional tests, away from the databases of a switch
+#define BENCH_BATCH         (128)
+#define BENCH_FIELDS        (8)
+#define BENCH_KEYS          (1000)
+
+static unique_ptr<DBConnector> connect(bench::State &state)
+{
+    try
+    {
+        return unique_ptr<DBConnector>(new DBConnector(BENCH_DB, bench::g_redisHost, bench::g_redisPort, 0));
+    }
+    catch (const system_error &e)
+    {
+        state.skip(string("redis unavailable: ") + e.what());
+        return nullptr;
+    }
+}
+
+static vector<FieldValueTuple> makeValues()
+{
+    vector<FieldValueTuple> values;
+
+    for (int i = 0; i < BENCH_FIELDS; i++)
+    {
+        values.push_back(FieldValueTuple("field" + to_string(i), "value" + to_string(i)));
+    }
+
+    return values;
+}
+
+/* Keys under tableName, whatever separator consumer_table_pops.lua used */
+static void clearTable(DBConnector *db, const string &tableName)
+{
+    RedisCommand keys;
+    keys.format("KEYS %s*", tableName.c_str());
+    RedisReply r(db, keys, REDIS_REPLY_ARRAY);
+
+    for (size_t i = 0; i < r.getContext()->elements; i++)
+    {
+        RedisCommand del;
+        del.format("DEL %s", r.getContext()->element[i]->str);
+        RedisReply deleted(db, del, REDIS_REPLY_INTEGER);
+    }
+}
+
+/* Waits for the consumer and pops until count entries were received */
+static void drain(Select &s, ConsumerTableBase &consumer, size_t count)
+{
+    deque<KeyOpFieldsValuesTuple> entries;
+    size_t received = 0;
+
+    while (received < count)
+    {
+        Selectable *sel;
+        if (s.select(&sel, 1000) != Select::OBJECT)
+        {
+            throw runtime_error("timed out waiting for entries");
+        }
+
+        consumer.pops(entries);
+        received += entries.size();
+    }
+}
+
+SWSS_BENCH(producer_state_table_to_consumer)
+{
+    auto db = connect(state);
+    if (!db)
+    {
+        return;
+    }
+
+    string tableName = "BENCH_STATE_TABLE";
+    RedisPipeline pipeline(db.get());
+    ProducerStateTable p(&pipeline, tableName, true);
+    ConsumerStateTable c(db.get(), tableName);
+    Select s;
+    s.addSelectable(&c);
+
+    vector<FieldValueTuple> values = makeValues();
+    vector<string> keys;
+    for (int i = 0; i < BENCH_BATCH; i++)
+    {
+        keys.push_back("key" + to_string(i));
+    }
+
+    state.setItemsPerIteration(BENCH_BATCH);
+
+    while (state.next())
+    {
+        for (const auto &k : keys)
+        {
+            p.set(k, values);
+        }
+        p.flush();
+
+        drain(s, c, BENCH_BATCH);
+    }
+
+    clearTable(db.get(), tableName);
+}
+
+SWSS_BENCH(producer_table_to_consumer)
+{
+    auto db = connect(state);
+    if (!db)
+    {
+        return;
+    }
+
+    string tableName = "BENCH_TABLE";
+    RedisPipeline pipeline(db.get());
+    ProducerTable p(&pipeline, tableName, true);
+    ConsumerTable c(db.get(), tableName);
+    Select s;
+    s.addSelectable(&c);
+
+    vector<FieldValueTuple> values = makeValues();
+    vector<string> keys;
+    for (int i = 0; i < BENCH_BATCH; i++)
+    {
+        keys.push_back("key" + to_string(i));
+    }
+
+    state.setItemsPerIteration(BENCH_BATCH);
+
+    while (state.next())
+    {
+        for (const auto &k : keys)
+        {
+            p.set(k, values);
+        }
+        p.flush();
+
+        drain(s, c, BENCH_BATCH);
+    }
+
+    clearTable(db.get(), tableName);
+}
+
+SWSS_BENCH(table_set)
+{
+    auto db = connect(state);
+    if (!db)
+    {
+        return;
+    }
+
+    string tableName = "BENCH_SET";
+    Table t(db.get(), tableName);
+    vector<FieldValueTuple> values = makeValues();
+    int i = 0;
+
+    while (state.next())
+    {
+        t.set("key" + to_string(i++ % BENCH_KEYS), values);
+    }
+
+    clearTable(db.get(), tableName);
+}
+
+SWSS_BENCH(table_get)
+{
+    auto db = connect(state);
+    if (!db)
+    {
+        return;
+    }
+
+    string tableName = "BENCH_GET";
+    RedisPipeline pipeline(db.get());
+    Table t(&pipeline, tableName, true);
+    vector<FieldValueTuple> values = makeValues();
+    vector<string> keys;
+
+    for (int i = 0; i < BENCH_KEYS; i++)
+    {
+        keys.push_back("key" + to_string(i));
+        t.set(keys.back(), values);
+    }
+    t.flush();
+
+    size_t i = 0;
+    while (state.next())
+    {
+        if (!t.get(keys[i++ % keys.size()], values))
+        {
+            throw runtime_error("key not found");
+        }
+    }
+
+    clearTable(db.get(), tableName);
+}
+
+SWSS_BENCH(table_getkeys)
+{
+    auto db = connect(state);
+    if (!db)
+    {
+        return;
+    }
+
+    string tableName = "BENCH_GETKEYS";
+    RedisPipeline pipeline(db.get());
+    Table t(&pipeline, tableName, true);
+    vector<FieldValueTuple> values = makeValues();
+
+    for (int i = 0; i < BENCH_KEYS; i++)
+    {
+        t.set("key" + to_string(i), values);
+    }
+    t.flush();
+
+    state.setItemsPerIteration(BENCH_KEYS);
+
+    vector<string> keys;
+    while (state.next())
+    {
+        t.getKeys(keys);
+    }
+
+    clearTable(db.get(), tableName);
+}
+
+SWSS_BENCH(notification_to_consumer)
+{
+    auto db = connect(state);
+    if (!db)
+    {
+        return;
+    }
+
+    string channel = "BENCH_NOTIFICATIONS";
+    NotificationProducer p(db.get(), channel);
+    NotificationConsumer c(db.get(), channel);
+    Select s;
+    s.addSelectable(&c);
+
+    vector<FieldValueTuple> values = makeValues();
+    state.setItemsPerIteration(BENCH_BATCH);
+
+    while (state.next())
+    {
+        for (int i = 0; i < BENCH_BATCH; i++)
+        {
+            p.send("SET", "key", values);
+        }
+
+        deque<KeyOpFieldsValuesTuple> entries;
+        size_t received = 0;
+
+        while (received < BENCH_BATCH)
+        {
+            Selectable *sel;
+            if (s.select(&sel, 1000) != Select::OBJECT)
+            {
+                throw runtime_error("timed out waiting for notifications");
+            }
+
+            c.pops(entries);
+            received += entries.size();
+        }
+    }
+}
@@ -0,0 +1,131 @@
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+#include "gtest/gtest.h"
+#include "common/flathashmap.h"
+#include "common/ipaddress.h"
+#include "common/ipprefix.h"
+#include "common/macaddress.h"
+
+using namespace std;
+using namespace swss;
+
+TEST(Hash, addresses)
+{
+    EXPECT_EQ(hash<IpAddress>()(IpAddress("10.0.0.1")), hash<IpAddress>()(IpAddress("10.0.0.1")));
+    EXPECT_NE(hash<IpAddress>()(IpAddress("10.0.0.1")), hash<IpAddress>()(IpAddress("10.0.0.2")));
+    EXPECT_NE(hash<IpAddress>()(IpAddress("::1")), hash<IpAddress>()(IpAddress("::2")));
+    EXPECT_NE(hash<IpPrefix>()(IpPrefix("10.0.0.0/8")), hash<IpPrefix>()(IpPrefix("10.0.0.0/9")));
+    EXPECT_EQ(hash<MacAddress>()(MacAddress("00:11:22:33:44:55")), hash<MacAddress>()(MacAddress("00:11:22:33:44:55")));
+    EXPECT_NE(hash<MacAddress>()(MacAddress("00:11:22:33:44:55")), hash<MacAddress>()(MacAddress("00:11:22:33:44:56")));
+
+    unordered_set<MacAddress> macs;
+    macs.insert(MacAddress("00:11:22:33:44:55"));
+    EXPECT_EQ(macs.count(MacAddress("00:11:22:33:44:55")), 1u);
+}
+
+static MacAddress randomMac(mt19937 &gen)
+{
+    uint8_t mac[ETHER_ADDR_LEN] = { 0, 0x11, 0x22, 0, 0, 0 };
+    /* Small key space so that inserts hit existing entries */
+    uint32_t r = static_cast<uint32_t>(gen() % 5000);
+    mac[4] = static_cast<uint8_t>(r >> 8);
+    mac[5] = static_cast<uint8_t>(r);
+    return MacAddress(mac);
+}
+
+TEST(FlatHashMap, random)
+{
+    mt19937 gen(1);
+    FlatHashMap<MacAddress, int> map;
+    unordered_map<MacAddress, int> expected;
+
+    for (int i = 0; i < 200000; i++)
+    {
+        MacAddress mac = randomMac(gen);
+
+        switch (gen() % 4)
+        {
+            case 0:
+            case 1:
+                EXPECT_EQ(map.insert(mac, i), expected.insert(make_pair(mac, i)).second);
+                break;
+            case 2:
+                EXPECT_EQ(map.erase(mac), expected.erase(mac) == 1);
+                break;
+            default:
+            {
+                const int *value = map.find(mac);
+                auto it = expected.find(mac);
+                ASSERT_EQ(value != nullptr, it != expected.end());
+                if (value)
+                {
+                    EXPECT_EQ(*value, it->second);
+                }
+                break;
+            }
+        }
+    }
+
+    EXPECT_EQ(map.size(), expected.size());
+
+    size_t count = 0;
+    for (const auto &entry : map)
+    {
+        EXPECT_EQ(expected.at(entry.first), entry.second);
+        count++;
+    }
+    EXPECT_EQ(count, expected.size());
+}
+
+TEST(FlatHashMap, operations)
+{
+    FlatHashMap<IpAddress, string> map;
+
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.find(IpAddress("10.0.0.1")), nullptr);
+    EXPECT_FALSE(map.erase(IpAddress("10.0.0.1")));
+
+    map[IpAddress("10.0.0.1")] = "a";
+    map[IpAddress("fc00::1")] = "b";
+    EXPECT_FALSE(map.insert(IpAddress("10.0.0.1"), "c"));
+    EXPECT_EQ(*map.find(IpAddress("10.0.0.1")), "a");
+    EXPECT_TRUE(map.contains(IpAddress("fc00::1")));
+    EXPECT_EQ(map.size(), 2u);
+
+    map.reserve(1000);
+    EXPECT_EQ(*map.find(IpAddress("fc00::1")), "b");
+
+    for (int i = 0; i < 1000; i++)
+    {
+        map[IpAddress(static_cast<uint32_t>(i))] = to_string(i);
+    }
+    EXPECT_EQ(map.size(), 1002u);
+    EXPECT_EQ(*map.find(IpAddress(static_cast<uint32_t>(500))), "500");
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_FALSE(map.contains(IpAddress("10.0.0.1")));
+}
+
+TEST(FlatHashSet, prefixes)
+{
+    FlatHashSet<IpPrefix> set;
+
+    EXPECT_TRUE(set.insert(IpPrefix("10.0.0.0/8")));
+    EXPECT_TRUE(set.insert(IpPrefix("10.0.0.0/16")));
+    EXPECT_FALSE(set.insert(IpPrefix("10.0.0.0/8")));
+    EXPECT_TRUE(set.contains(IpPrefix("10.0.0.0/16")));
+    EXPECT_FALSE(set.contains(IpPrefix("10.0.0.0/24")));
+
+    size_t count = 0;
+    for (const auto &prefix : set)
+    {
+        EXPECT_TRUE(prefix.getMaskLength() == 8 || prefix.getMaskLength() == 16);
+        count++;
+    }
+    EXPECT_EQ(count, 2u);
+
+    EXPECT_TRUE(set.erase(IpPrefix("10.0.0.0/8")));
+    EXPECT_EQ(set.size(), 1u);
+}
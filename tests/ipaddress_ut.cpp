@@ -1,4 +1,6 @@
 #include <gtest/gtest.h>
+#include <random>
+#include <arpa/inet.h>
 #include "common/ipaddresses.h"
 
 using namespace std;
@@ -72,3 +74,107 @@ TEST(IpAddress, getAddrScope)
     EXPECT_EQ(IpAddress::AddrScope::GLOBAL_SCOPE, ip17.getAddrScope());
     EXPECT_EQ(IpAddress::AddrScope::HOST_SCOPE,   ip18.getAddrScope());
 }
+
+/* parse() and format() must agree with inet_pton() and inet_ntop() */
+static void checkParse(const string &str)
+{
+    unsigned char expected[16];
+    int family = str.find(':') != string::npos ? AF_INET6 : AF_INET;
+    bool valid = inet_pton(family, str.c_str(), expected) == 1;
+
+    IpAddress ip;
+    ASSERT_EQ(IpAddress::parse(str.data(), str.size(), ip), valid) << str;
+
+    if (valid)
+    {
+        ip_addr_t addr = ip.getIp();
+        EXPECT_EQ(ip.isV4(), family == AF_INET) << str;
+        EXPECT_EQ(memcmp(&addr.ip_addr, expected, family == AF_INET ? 4 : 16), 0) << str;
+    }
+}
+
+static void checkFormat(const IpAddress &ip)
+{
+    char expected[INET6_ADDRSTRLEN];
+    ip_addr_t addr = ip.getIp();
+    ASSERT_NE(inet_ntop(addr.family, &addr.ip_addr, expected, sizeof(expected)), nullptr);
+
+    char buf[IpAddress::MAX_STRING_LEN];
+    EXPECT_EQ(string(buf, ip.format(buf)), string(expected));
+}
+
+TEST(IpAddress, parse)
+{
+    const char *samples[] = {
+        "0.0.0.0", "255.255.255.255", "1.2.3.4", "01.2.3.4", "1.2.3", "1.2.3.4.5", "256.1.1.1",
+        "1..2.3", "1.2.3.", ".1.2.3", "1.2.3.4 ", "", "::", "::1", "1::", ":1::", "1:::2",
+        "1:2:3:4:5:6:7:8", "1:2:3:4:5:6:7:8:9", "1:2:3:4:5:6:7::", "::2:3:4:5:6:7:8",
+        "1:2:3:4:5:6:7::8", "12345::", "::ffff:1.2.3.4", "::1.2.3.4", "1:2:3:4:5:6:1.2.3.4",
+        "1:2:3:4:5:6:7:1.2.3.4", "::ffff:1.2.3", "::ffff:1.2.3.4:1", "fe80::1%eth0", "FE80::AbCd",
+        "1:2:3:4:5:6:7:", ":", "1.2.3.04", "::0.0.0.0", "::ffff:256.1.1.1",
+    };
+
+    for (auto s : samples)
+    {
+        checkParse(s);
+    }
+
+    mt19937 gen(1);
+    const char alphabet[] = "0123456789abcdefABCDEF:..:";
+
+    for (int i = 0; i < 100000; i++)
+    {
+        string s;
+        size_t len = gen() % 24;
+        for (size_t j = 0; j < len; j++)
+        {
+            s += alphabet[gen() % (sizeof(alphabet) - 1)];
+        }
+        checkParse(s);
+    }
+}
+
+TEST(IpAddress, format)
+{
+    mt19937 gen(1);
+
+    for (int i = 0; i < 100000; i++)
+    {
+        ip_addr_t addr;
+        addr.family = i % 4 ? AF_INET6 : AF_INET;
+        for (int j = 0; j < 16; j++)
+        {
+            /* Mostly zero bytes, so that runs of zero words get compressed */
+            addr.ip_addr.ipv6_addr[j] = (unsigned char)(gen() % 3 ? 0 : gen());
+        }
+        if (i % 8 == 1)
+        {
+            memset(addr.ip_addr.ipv6_addr, 0, 10);
+            addr.ip_addr.ipv6_addr[10] = addr.ip_addr.ipv6_addr[11] = 0xff;
+        }
+
+        IpAddress ip(addr);
+        checkFormat(ip);
+        EXPECT_EQ(IpAddress(ip.to_string()), ip);
+    }
+}
+
+TEST(IpAddress, literal)
+{
+    static constexpr IpAddress loopback(127, 0, 0, 1);
+    static_assert(sizeof(loopback) == sizeof(ip_addr_t), "IpAddress must stay an ip_addr_t");
+
+    EXPECT_EQ(loopback, IpAddress("127.0.0.1"));
+    EXPECT_EQ(IpAddress(255, 255, 255, 255), IpAddress("255.255.255.255"));
+    EXPECT_EQ(IpAddress(htonl(0x0a000001)), IpAddress(10, 0, 0, 1));
+}
+
+TEST(IpAddress, isZero)
+{
+    EXPECT_TRUE(IpAddress("0.0.0.0").isZero());
+    EXPECT_TRUE(IpAddress("::").isZero());
+    EXPECT_FALSE(IpAddress("0.0.0.1").isZero());
+    EXPECT_FALSE(IpAddress("::1").isZero());
+    EXPECT_FALSE(IpAddress("1::").isZero());
+    EXPECT_FALSE(IpAddress("::ffff:0.0.0.0").isZero());
+}
@@ -144,3 +144,87 @@ TEST(IpPrefix, getSubnet)
     EXPECT_EQ("2001:4898:f0::/45", prefix9.getSubnet().to_string());
     EXPECT_EQ("2001:4898:f0:f153:357c:77b2:49c9:627c/128", prefix10.getSubnet().to_string());
 }
+
+TEST(IpPrefix, parse)
+{
+    IpPrefix prefix;
+    string s = "10.1.0.0/16 trailing";
+
+    EXPECT_TRUE(IpPrefix::parse(s.data(), 11, prefix));
+    EXPECT_EQ(prefix, IpPrefix("10.1.0.0/16"));
+    EXPECT_EQ(prefix.to_string(), "10.1.0.0/16");
+
+    EXPECT_TRUE(IpPrefix::parse("fc00::/7", 8, prefix));
+    EXPECT_EQ(prefix.getMaskLength(), 7);
+    EXPECT_EQ(prefix.to_string(), "fc00::/7");
+
+    EXPECT_TRUE(IpPrefix::parse("/8", 2, prefix));
+    EXPECT_EQ(prefix.to_string(), "0.0.0.0/8");
+
+    EXPECT_TRUE(IpPrefix::parse("::1", 3, prefix));
+    EXPECT_EQ(prefix.getMaskLength(), 128);
+
+    EXPECT_FALSE(IpPrefix::parse("1.1.1.1/", 8, prefix));
+    EXPECT_FALSE(IpPrefix::parse("1.1.1.1/33", 10, prefix));
+    EXPECT_FALSE(IpPrefix::parse("1.1.1.1/1x", 10, prefix));
+    EXPECT_FALSE(IpPrefix::parse("::/1280", 7, prefix));
+    EXPECT_FALSE(IpPrefix::parse("1.1.1/24", 8, prefix));
+
+    char buf[IpPrefix::MAX_STRING_LEN];
+    IpPrefix longest("ffff:ffff:ffff:ffff:ffff:ffff:ffff:ffff/128");
+    EXPECT_EQ(string(buf, longest.format(buf)), "ffff:ffff:ffff:ffff:ffff:ffff:ffff:ffff/128");
+
+    EXPECT_EQ(IpPrefix("2001:db8::1/64").getSubnet().to_string(), "2001:db8::/64");
+}
+
+TEST(IpPrefix, masks)
+{
+    IpAddress v4("10.20.30.40");
+    IpAddress v6("2001:4898:f0:f153:357c:77b2:49c9:627c");
+
+    for (int len = 0; len <= 128; len++)
+    {
+        /* Bit by bit reference */
+        ip_addr_t mask = v6.getIp();
+        for (int i = 0; i < 16; i++)
+        {
+            int bits = min(max(len - 8 * i, 0), 8);
+            mask.ip_addr.ipv6_addr[i] = (uint8_t)(0xff00 >> bits);
+        }
+
+        IpPrefix prefix(v6, len);
+        EXPECT_EQ(prefix.getMask(), IpAddress(mask));
+
+        ip_addr_t subnet = v6.getIp(), bcast = v6.getIp();
+        for (int i = 0; i < 16; i++)
+        {
+            subnet.ip_addr.ipv6_addr[i] &= mask.ip_addr.ipv6_addr[i];
+            bcast.ip_addr.ipv6_addr[i] |= (uint8_t)~mask.ip_addr.ipv6_addr[i];
+        }
+        EXPECT_EQ(prefix.getSubnet().getIp(), IpAddress(subnet));
+        EXPECT_EQ(prefix.getBroadcastIp(), IpAddress(bcast));
+        EXPECT_TRUE(prefix.isAddressInSubnet(IpAddress(subnet)));
+        EXPECT_TRUE(prefix.isAddressInSubnet(IpAddress(bcast)));
+
+        if (len > 0)
+        {
+            /* Flip the last bit of the prefix */
+            ip_addr_t outside = v6.getIp();
+            outside.ip_addr.ipv6_addr[(len - 1) / 8] ^= (uint8_t)(0x80 >> ((len - 1) % 8));
+            EXPECT_FALSE(prefix.isAddressInSubnet(IpAddress(outside)));
+        }
+
+        if (len <= 32)
+        {
+            IpPrefix prefix4(v4, len);
+            uint32_t mask4 = len ? htonl(0xffffffffu << (32 - len)) : 0;
+            EXPECT_EQ(prefix4.getMask(), IpAddress(mask4));
+            EXPECT_EQ(prefix4.getSubnet().getIp(), IpAddress(v4.getV4Addr() & mask4));
+            EXPECT_EQ(prefix4.getBroadcastIp(), IpAddress(v4.getV4Addr() | ~mask4));
+        }
+    }
+
+    static_assert(IpPrefix::getV4Mask(0) == 0, "");
+    static_assert(IpPrefix::getV4Mask(32) == 0xffffffffu, "");
+    static_assert(IpPrefix::getV6MaskWord(64, 0) == ~0ULL && IpPrefix::getV6MaskWord(64, 1) == 0, "");
+}
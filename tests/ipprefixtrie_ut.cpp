@@ -0,0 +1,156 @@
+#include <map>
+#include <random>
+#include "gtest/gtest.h"
+#include "common/ipprefixtrie.h"
+
+using namespace std;
+using namespace swss;
+
+TEST(IpPrefixTrie, basic)
+{
+    IpPrefixTrie<int> trie;
+
+    EXPECT_TRUE(trie.insert(IpPrefix("10.0.0.0/8"), 8));
+    EXPECT_TRUE(trie.insert(IpPrefix("10.1.0.0/16"), 16));
+    EXPECT_TRUE(trie.insert(IpPrefix("10.1.1.0/24"), 24));
+    EXPECT_TRUE(trie.insert(IpPrefix("0.0.0.0/0"), 0));
+    EXPECT_TRUE(trie.insert(IpPrefix("fc00::/7"), 7));
+    EXPECT_TRUE(trie.insert(IpPrefix("fc00:1::/64"), 64));
+    EXPECT_FALSE(trie.insert(IpPrefix("10.1.1.1/24"), 25));
+    EXPECT_EQ(trie.size(), 6u);
+
+    IpPrefix match;
+    EXPECT_EQ(*trie.lookup(IpAddress("10.1.1.1"), &match), 25);
+    EXPECT_EQ(match, IpPrefix("10.1.1.0/24"));
+    EXPECT_EQ(*trie.lookup(IpAddress("10.1.2.1")), 16);
+    EXPECT_EQ(*trie.lookup(IpAddress("10.2.2.1")), 8);
+    EXPECT_EQ(*trie.lookup(IpAddress("11.0.0.1"), &match), 0);
+    EXPECT_EQ(match, IpPrefix("0.0.0.0/0"));
+    EXPECT_EQ(*trie.lookup(IpAddress("fc00:1::1"), &match), 64);
+    EXPECT_EQ(match, IpPrefix("fc00:1::/64"));
+    EXPECT_EQ(*trie.lookup(IpAddress("fd00::1")), 7);
+    EXPECT_EQ(trie.lookup(IpAddress("2001::1")), nullptr);
+
+    EXPECT_EQ(*trie.find(IpPrefix("10.1.0.0/16")), 16);
+    EXPECT_EQ(trie.find(IpPrefix("10.1.0.0/17")), nullptr);
+    EXPECT_EQ(trie.find(IpPrefix("10.0.0.0/7")), nullptr);
+
+    EXPECT_TRUE(trie.remove(IpPrefix("10.1.0.0/16")));
+    EXPECT_FALSE(trie.remove(IpPrefix("10.1.0.0/16")));
+    EXPECT_EQ(*trie.lookup(IpAddress("10.1.2.1")), 8);
+    EXPECT_EQ(*trie.lookup(IpAddress("10.1.1.1")), 25);
+    EXPECT_TRUE(trie.remove(IpPrefix("0.0.0.0/0")));
+    EXPECT_EQ(trie.lookup(IpAddress("11.0.0.1")), nullptr);
+    EXPECT_EQ(trie.size(), 4u);
+}
+
+static IpPrefix randomPrefix(mt19937 &gen, bool v4)
+{
+    ip_addr_t ip;
+
+    if (v4)
+    {
+        ip.family = AF_INET;
+        /* Few top bits so prefixes overlap */
+        ip.ip_addr.ipv4_addr = htonl(static_cast<uint32_t>(gen()) & 0xf0ff00ff);
+        return IpPrefix(IpAddress(ip), static_cast<int>(gen() % 33));
+    }
+
+    ip.family = AF_INET6;
+    for (int i = 0; i < 16; i++)
+    {
+        ip.ip_addr.ipv6_addr[i] = static_cast<unsigned char>(i < 2 || i == 8 || i == 15 ? gen() & 0x3 : 0);
+    }
+    return IpPrefix(IpAddress(ip), static_cast<int>(gen() % 129));
+}
+
+static const int *bruteForce(const map<IpPrefix, int> &prefixes, const IpAddress &addr)
+{
+    const int *best = nullptr;
+    int bestLen = -1;
+
+    for (const auto &p : prefixes)
+    {
+        if (p.first.isAddressInSubnet(addr) && p.first.getMaskLength() > bestLen)
+        {
+            best = &p.second;
+            bestLen = p.first.getMaskLength();
+        }
+    }
+
+    return best;
+}
+
+TEST(IpPrefixTrie, random)
+{
+    mt19937 gen(1);
+
+    for (bool v4 : { true, false })
+    {
+        IpPrefixTrie<int> trie;
+        map<IpPrefix, int> prefixes;
+
+        for (int i = 0; i < 2000; i++)
+        {
+            IpPrefix p = randomPrefix(gen, v4).getSubnet();
+            bool added = prefixes.find(p) == prefixes.end();
+            prefixes[p] = i;
+            EXPECT_EQ(trie.insert(p, i), added);
+        }
+        EXPECT_EQ(trie.size(), prefixes.size());
+
+        for (int round = 0; round < 2; round++)
+        {
+            for (int i = 0; i < 2000; i++)
+            {
+                IpAddress addr = randomPrefix(gen, v4).getIp();
+                const int *expected = bruteForce(prefixes, addr);
+                const int *value = trie.lookup(addr);
+
+                ASSERT_EQ(expected == nullptr, value == nullptr) << addr.to_string();
+                if (expected)
+                {
+                    EXPECT_EQ(*expected, *value) << addr.to_string();
+                }
+            }
+
+            /* Drop every other prefix, then check again */
+            bool drop = true;
+            for (auto it = prefixes.begin(); it != prefixes.end();)
+            {
+                if (drop)
+                {
+                    EXPECT_TRUE(trie.remove(it->first));
+                    EXPECT_EQ(trie.find(it->first), nullptr);
+                    it = prefixes.erase(it);
+                }
+                else
+                {
+                    EXPECT_EQ(*trie.find(it->first), it->second);
+                    ++it;
+                }
+                drop = !drop;
+            }
+            EXPECT_EQ(trie.size(), prefixes.size());
+        }
+    }
+}
+
+TEST(IpPrefixTrie, build)
+{
+    vector<pair<IpPrefix, string>> entries = {
+        { IpPrefix("192.168.0.0/16"), "a" },
+        { IpPrefix("192.168.1.0/24"), "b" },
+        { IpPrefix("2001:db8::/32"), "c" },
+    };
+
+    IpPrefixTrie<string> trie;
+    trie.insert(IpPrefix("10.0.0.0/8"), "x");
+    trie.build(entries);
+
+    EXPECT_EQ(trie.size(), 3u);
+    EXPECT_EQ(trie.lookup(IpAddress("10.0.0.1")), nullptr);
+    EXPECT_EQ(*trie.lookup(IpAddress("192.168.1.1")), "b");
+    EXPECT_EQ(*trie.lookup(IpAddress("192.168.2.1")), "a");
+    EXPECT_EQ(*trie.lookup(IpAddress("2001:db8::1")), "c");
+}
@@ -0,0 +1,143 @@
+#include <string>
+#include <net/if.h>
+#include <netlink/route/link.h>
+
+#include "gtest/gtest.h"
+#include "common/linkcache.h"
+#include "common/netdispatcher.h"
+#include "common/select.h"
+#include "common/selectable.h"
+
+using namespace std;
+using namespace swss;
+
+#define TEST_LINK   "swsslctest0"
+
+TEST(LinkCache, lookup)
+{
+    LinkCache &cache = LinkCache::getInstance();
+
+    EXPECT_EQ(cache.ifindexToName(static_cast<int>(if_nametoindex("lo"))), "lo");
+
+    struct rtnl_link *link = cache.getLinkByName("lo");
+    ASSERT_NE(link, nullptr);
+    rtnl_link_put(link);
+}
+
+TEST(LinkCache, negative)
+{
+    LinkCache &cache = LinkCache::getInstance();
+    Counter &refills = MetricsRegistry::getInstance().getCounter("linkcache.refills");
+    Counter &misses = MetricsRegistry::getInstance().getCounter("linkcache.misses");
+
+    uint64_t refillsBefore = refills.get();
+    uint64_t missesBefore = misses.get();
+
+    /* Repeated misses neither read updates nor dump the links again each time */
+    for (int i = 0; i < 100; i++)
+    {
+        EXPECT_EQ(cache.ifindexToName(60000), "60000");
+        EXPECT_EQ(cache.ifindexToName(1 << 30), to_string(1 << 30));
+    }
+
+    EXPECT_EQ(misses.get(), missesBefore + 2);
+    EXPECT_LE(refills.get(), refillsBefore + 1);
+}
+
+class CountingBatchHandler : public NetBatchMsg
+{
+public:
+    void onMsgBatch(int, const vector<struct nl_object *> &objs) override
+    {
+        count += objs.size();
+    }
+
+    size_t count = 0;
+};
+
+/* Lookups are made from NetDispatcher handlers, in the middle of a batch */
+TEST(LinkCache, pending_batch)
+{
+    LinkCache &cache = LinkCache::getInstance();
+    CountingBatchHandler handler;
+    NetDispatcher &dispatcher = NetDispatcher::getInstance();
+    dispatcher.registerBatchHandler(RTM_NEWLINK, &handler);
+
+    struct ifinfomsg ifi = {};
+    ifi.ifi_family = AF_UNSPEC;
+    ifi.ifi_index = 100;
+
+    struct nl_msg *msg = nlmsg_alloc_simple(RTM_NEWLINK, 0);
+    nlmsg_set_proto(msg, NETLINK_ROUTE);
+    nlmsg_append(msg, &ifi, sizeof(ifi), NLMSG_ALIGNTO);
+    nla_put_string(msg, IFLA_IFNAME, "Ethernet0");
+    dispatcher.onNetlinkMessage(msg);
+    nlmsg_free(msg);
+
+    /* Misses read the link updates, without flushing the batch */
+    EXPECT_EQ(cache.ifindexToName(60001), "60001");
+    EXPECT_EQ(cache.getLinkByName("Ethernet-none"), nullptr);
+    EXPECT_EQ(handler.count, 0u);
+
+    dispatcher.flush();
+    EXPECT_EQ(handler.count, 1u);
+    dispatcher.unregisterMessageHandler(RTM_NEWLINK);
+}
+
+/* Needs CAP_NET_ADMIN, does nothing without it */
+TEST(LinkCache, updates)
+{
+    struct nl_sock *sock = nl_socket_alloc();
+    ASSERT_NE(sock, nullptr);
+    ASSERT_EQ(nl_connect(sock, NETLINK_ROUTE), 0);
+
+    LinkCache &cache = LinkCache::getInstance();
+    Select s;
+    s.addSelectable(cache.getSelectable());
+
+    struct rtnl_link *link = rtnl_link_alloc();
+    rtnl_link_set_name(link, TEST_LINK);
+    rtnl_link_set_type(link, "dummy");
+    int err = rtnl_link_add(sock, link, NLM_F_CREATE | NLM_F_EXCL);
+    rtnl_link_put(link);
+
+    if (err < 0)
+    {
+        nl_socket_free(sock);
+        return;
+    }
+
+    int ifindex = static_cast<int>(if_nametoindex(TEST_LINK));
+
+    /* Applied through Select, without dumping */
+    Counter &refills = MetricsRegistry::getInstance().getCounter("linkcache.refills");
+    uint64_t refillsBefore = refills.get();
+
+    Selectable *sel;
+    while (s.select(&sel, 100) == Select::OBJECT)
+    {
+    }
+    EXPECT_EQ(cache.ifindexToName(ifindex), TEST_LINK);
+
+    struct rtnl_link *change = rtnl_link_alloc();
+    rtnl_link_set_name(change, TEST_LINK "r");
+    struct rtnl_link *orig = cache.getLinkByName(TEST_LINK);
+    ASSERT_NE(orig, nullptr);
+    EXPECT_EQ(rtnl_link_change(sock, orig, change, 0), 0);
+    rtnl_link_put(change);
+
+    while (s.select(&sel, 100) == Select::OBJECT)
+    {
+    }
+    EXPECT_EQ(cache.ifindexToName(ifindex), TEST_LINK "r");
+
+    EXPECT_EQ(rtnl_link_delete(sock, orig), 0);
+    rtnl_link_put(orig);
+
+    /* Without Select, the miss reads the pending update */
+    usleep(100000);
+    EXPECT_EQ(cache.ifindexToName(ifindex), to_string(ifindex));
+    EXPECT_EQ(refills.get(), refillsBefore);
+
+    nl_socket_free(sock);
+}
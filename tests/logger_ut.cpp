@@ -0,0 +1,147 @@
+#include <thread>
+#include <chrono>
+#include <vector>
+#include "gtest/gtest.h"
+#include "common/logger.h"
+#include "common/metrics.h"
+
+using namespace std;
+using namespace swss;
+
+#define NUMBER_OF_THREADS   (4)
+#define NUMBER_OF_MESSAGES  (200)
+
+static uint64_t written()
+{
+    return MetricsRegistry::getInstance().getCounter("logger.async_written").get();
+}
+
+TEST(Logger, async)
+{
+    Logger::Priority prio = Logger::getMinPrio();
+    Logger::setMinPrio(Logger::SWSS_DEBUG);
+
+    uint64_t writtenBefore = written();
+    uint64_t droppedBefore = Logger::getDroppedCount();
+
+    /* Rings smaller than a thread's burst, so some messages get dropped */
+    Logger::setAsync(true, 16);
+    EXPECT_TRUE(Logger::isAsync());
+
+    vector<thread> threads;
+    for (int i = 0; i < NUMBER_OF_THREADS; i++)
+    {
+        threads.emplace_back([i]() {
+            for (int j = 0; j < NUMBER_OF_MESSAGES; j++)
+            {
+                SWSS_LOG_DEBUG("thread %d message %d", i, j);
+            }
+        });
+    }
+
+    for (auto &t : threads)
+    {
+        t.join();
+    }
+
+    Logger::flush();
+
+    uint64_t total = (written() - writtenBefore) + (Logger::getDroppedCount() - droppedBefore);
+    EXPECT_EQ(total, (uint64_t)(NUMBER_OF_THREADS * NUMBER_OF_MESSAGES));
+    EXPECT_GT(written() - writtenBefore, 0u);
+
+    Logger::setAsync(false);
+    EXPECT_FALSE(Logger::isAsync());
+
+    /* Synchronous again, nothing goes through the rings */
+    writtenBefore = written();
+    SWSS_LOG_DEBUG("synchronous message");
+    Logger::flush();
+    EXPECT_EQ(written(), writtenBefore);
+
+    Logger::setMinPrio(prio);
+}
+
+/* Logs from its destructor, after the thread's ring is gone */
+struct LateLogger
+{
+    bool armed = false;
+
+    ~LateLogger()
+    {
+        if (armed)
+        {
+            /* Long enough for the writer to free the orphaned ring */
+            this_thread::sleep_for(chrono::milliseconds(100));
+            SWSS_LOG_DEBUG("message from the thread teardown");
+        }
+    }
+};
+
+TEST(Logger, async_thread_teardown)
+{
+    Logger::Priority prio = Logger::getMinPrio();
+    Logger::setMinPrio(Logger::SWSS_DEBUG);
+    Logger::setAsync(true);
+
+    uint64_t writtenBefore = written();
+
+    thread t([]() {
+        /* Constructed first, so destroyed after the ring handle */
+        static thread_local LateLogger late;
+        late.armed = true;
+
+        SWSS_LOG_DEBUG("message from the thread");
+    });
+    t.join();
+
+    /* The late message was written synchronously */
+    Logger::flush();
+    EXPECT_EQ(written() - writtenBefore, 1u);
+
+    Logger::setAsync(false);
+    Logger::setMinPrio(prio);
+}
+
+TEST(Logger, async_filtered)
+{
+    Logger::Priority prio = Logger::getMinPrio();
+    Logger::setMinPrio(Logger::SWSS_NOTICE);
+    Logger::setAsync(true);
+
+    uint64_t writtenBefore = written();
+    SWSS_LOG_DEBUG("filtered message");
+    SWSS_LOG_NOTICE("async message");
+    Logger::flush();
+    EXPECT_EQ(written(), writtenBefore + 1);
+
+    Logger::setAsync(false);
+    Logger::setMinPrio(prio);
+}
+
+static int evaluated;
+
+static const char *argument()
+{
+    evaluated++;
+    return "argument";
+}
+
+TEST(Logger, lazy_arguments)
+{
+    Logger::Priority prio = Logger::getMinPrio();
+    Logger::setMinPrio(Logger::SWSS_NOTICE);
+
+    evaluated = 0;
+    SWSS_LOG_DEBUG("%s", argument());
+    SWSS_LOG_INFO("%s", argument());
+    EXPECT_EQ(evaluated, 0);
+    EXPECT_FALSE(Logger::isEnabled(Logger::SWSS_INFO));
+    EXPECT_TRUE(Logger::isEnabled(Logger::SWSS_NOTICE));
+
+    Logger::setMinPrio(Logger::SWSS_DEBUG);
+    SWSS_LOG_DEBUG("%s", argument());
+    EXPECT_EQ(evaluated, 1);
+
+    Logger::setMinPrio(prio);
+}
@@ -62,3 +62,31 @@ TEST(MacAddress, parse)
 
     EXPECT_THROW(MacAddress("52:54:00:25:E9"), invalid_argument);
 }
+
+TEST(MacAddress, batch)
+{
+    vector<string> strs = { "52:54:00:ac:3a:99", "A0-F9-aA-fF-0a-9f", "52:54:00:25:Z9:E9", "00:00:00:00:00:01" };
+    vector<const char *> ptrs;
+    vector<size_t> lens;
+
+    for (const auto &s : strs)
+    {
+        ptrs.push_back(s.data());
+        lens.push_back(s.size());
+    }
+
+    MacAddress macs[4];
+    bool valid[4];
+    EXPECT_EQ(MacAddress::parse(ptrs.data(), lens.data(), 4, macs, valid), 3u);
+    EXPECT_TRUE(valid[0]);
+    EXPECT_TRUE(valid[1]);
+    EXPECT_FALSE(valid[2]);
+    EXPECT_TRUE(valid[3]);
+    EXPECT_EQ(macs[0], MacAddress("52:54:00:ac:3a:99"));
+    EXPECT_EQ(macs[1], MacAddress("a0:f9:aa:ff:0a:9f"));
+    EXPECT_TRUE(!macs[2]);
+
+    char buf[4 * MacAddress::STRING_LEN];
+    char *end = MacAddress::format(macs, 4, buf);
+    EXPECT_EQ(string(buf, end), "52:54:00:ac:3a:99a0:f9:aa:ff:0a:9f00:00:00:00:00:0000:00:00:00:00:01");
+}
@@ -0,0 +1,229 @@
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "gtest/gtest.h"
+#include "common/dbconnector.h"
+#include "common/select.h"
+#include "common/table.h"
+#include "common/producerstatetable.h"
+#include "common/consumerstatetable.h"
+#include "common/metrics.h"
+#include "common/metricsserver.h"
+
+using namespace std;
+using namespace swss;
+
+#define TEST_DB           APPL_DB
+
+static inline void clearDB()
+{
+    DBConnector db(TEST_DB, "localhost", 6379, 0);
+    RedisReply r(&db, "FLUSHALL", REDIS_REPLY_STATUS);
+    r.checkStatusOK();
+}
+
+static int connectSocket(const string &path)
+{
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    EXPECT_NE(fd, -1);
+
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    EXPECT_EQ(connect(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)), 0);
+    return fd;
+}
+
+static string readSocket(const string &path)
+{
+    int fd = connectSocket(path);
+
+    string out;
+    char buf[4096];
+    ssize_t n;
+    while ((n = read(fd, buf, sizeof(buf))) > 0)
+    {
+        out.append(buf, static_cast<size_t>(n));
+    }
+    close(fd);
+    return out;
+}
+
+TEST(Metrics, registry)
+{
+    MetricsRegistry &registry = MetricsRegistry::getInstance();
+
+    Counter &c = registry.getCounter("ut.counter");
+    EXPECT_EQ(&c, &registry.getCounter("ut.counter"));
+    c.reset();
+    c.inc();
+    c.inc(2);
+    EXPECT_EQ(c.get(), 3U);
+
+    Gauge &g = registry.getGauge("ut.gauge");
+    g.set(5);
+    g.add(-2);
+    EXPECT_EQ(g.get(), 3);
+
+    Histogram &h = registry.getHistogram("ut.histogram");
+    h.reset();
+    h.record(10);
+
+    string dump = registry.dump();
+    EXPECT_NE(dump.find("ut.counter value 3\n"), string::npos);
+    EXPECT_NE(dump.find("ut.gauge value 3\n"), string::npos);
+    EXPECT_NE(dump.find("ut.histogram count 1\n"), string::npos);
+    EXPECT_NE(dump.find("ut.histogram max 10\n"), string::npos);
+}
+
+TEST(Metrics, server)
+{
+    string path = "/tmp/swss_metrics_ut.sock";
+    MetricsServer server(path);
+    MetricsRegistry::getInstance().getCounter("ut.server").inc();
+
+    Select s;
+    s.addSelectable(&server);
+
+    string out;
+    thread reader([&]() { out = readSocket(path); });
+
+    Selectable *sel;
+    EXPECT_EQ(s.select(&sel, 1000), Select::OBJECT);
+    EXPECT_EQ(sel, &server);
+    reader.join();
+
+    EXPECT_NE(out.find("ut.server value"), string::npos);
+    EXPECT_NE(out.find("select.wakeups value"), string::npos);
+}
+
+TEST(Metrics, server_slow_clients)
+{
+    string path = "/tmp/swss_metrics_slow_ut.sock";
+    MetricsServer server(path);
+
+    /* More than the socket buffers hold */
+    for (int i = 0; i < 20000; i++)
+    {
+        MetricsRegistry::getInstance().getCounter("ut.server.slow." + to_string(i));
+    }
+
+    /* Clients not reading do not block the loop */
+    vector<int> clients;
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i <= MetricsServer::MAX_CLIENTS; i++)
+    {
+        clients.push_back(connectSocket(path));
+        server.readData();
+    }
+    EXPECT_LT(chrono::steady_clock::now() - start, chrono::milliseconds(500));
+
+    /* Beyond MAX_CLIENTS, closed without metrics */
+    char buf[4096];
+    EXPECT_EQ(read(clients.back(), buf, sizeof(buf)), 0);
+
+    /* The others are dropped once stuck for too long, letting new ones in */
+    this_thread::sleep_for(chrono::milliseconds(MetricsServer::CLIENT_TIMEOUT_MS + 100));
+
+    Select s;
+    s.addSelectable(&server);
+
+    string out;
+    atomic<bool> done(false);
+    thread reader([&]() { out = readSocket(path); done = true; });
+
+    Selectable *sel;
+    for (int i = 0; i < 50 && !done; i++)
+    {
+        s.select(&sel, 100);
+    }
+    reader.join();
+
+    EXPECT_NE(out.find("ut.server.slow.19999 value"), string::npos);
+
+    size_t partial = 0;
+    ssize_t n;
+    while ((n = read(clients.front(), buf, sizeof(buf))) > 0)
+    {
+        partial += static_cast<size_t>(n);
+    }
+    EXPECT_GT(partial, 0U);
+    EXPECT_LT(partial, out.size());
+
+    for (int fd: clients)
+    {
+        close(fd);
+    }
+}
+
+TEST(Metrics, server_idle_timeout)
+{
+    string path = "/tmp/swss_metrics_idle_ut.sock";
+    MetricsServer server(path);
+
+    /* More than the socket buffers hold */
+    for (int i = 0; i < 20000; i++)
+    {
+        MetricsRegistry::getInstance().getCounter("ut.server.slow." + to_string(i));
+    }
+
+    int client = connectSocket(path);
+    server.readData();
+
+    /* Nothing else happens, the timer alone brings the loop back */
+    Select s;
+    s.addSelectable(&server);
+
+    Selectable *sel;
+    EXPECT_EQ(s.select(&sel, MetricsServer::CLIENT_TIMEOUT_MS * 2), Select::OBJECT);
+    EXPECT_EQ(sel, &server);
+
+    /* The connection is closed after what was sent */
+    char buf[4096];
+    ssize_t n;
+    while ((n = recv(client, buf, sizeof(buf), MSG_DONTWAIT)) > 0)
+    {
+    }
+    EXPECT_EQ(n, 0);
+
+    close(client);
+}
+
+TEST(Metrics, export_to_table)
+{
+    clearDB();
+
+    DBConnector db(TEST_DB, "localhost", 6379, 0);
+    string tableName = "UT_METRICS";
+    ProducerStateTable p(&db, tableName);
+    ConsumerStateTable c(&db, tableName);
+
+    MetricsRegistry &registry = MetricsRegistry::getInstance();
+    uint64_t pops = registry.getCounter("consumer." + tableName + ".pops").get();
+    uint64_t entries = registry.getCounter("consumer." + tableName + ".entries").get();
+
+    p.set("key", { { "field", "value" } });
+    std::deque<KeyOpFieldsValuesTuple> vkco;
+    c.pops(vkco);
+
+    EXPECT_EQ(registry.getCounter("consumer." + tableName + ".pops").get(), pops + 1);
+    EXPECT_EQ(registry.getCounter("consumer." + tableName + ".entries").get(), entries + 1);
+    EXPECT_GT(registry.getCounter("redis_pipeline." + to_string(TEST_DB) + ".commands").get(), 0U);
+
+    DBConnector stateDb(STATE_DB, "localhost", 6379, 0);
+    Table metrics(&stateDb, "METRICS");
+    registry.exportTo(metrics);
+
+    vector<FieldValueTuple> values;
+    EXPECT_TRUE(metrics.get("consumer." + tableName + ".pops", values));
+    ASSERT_EQ(values.size(), 1U);
+    EXPECT_EQ(fvField(values[0]), "value");
+    EXPECT_TRUE(metrics.get("consumer." + tableName + ".batch_size", values));
+    EXPECT_EQ(values.size(), 6U);
+}
@@ -0,0 +1,375 @@
+#include <string>
+#include <vector>
+#include <linux/if.h>
+#include <netlink/msg.h>
+#include <netlink/attr.h>
+#include <netlink/route/link.h>
+
+#include "gtest/gtest.h"
+#include "common/netdispatcher.h"
+#include "common/netlink.h"
+#include "common/select.h"
+
+using namespace std;
+using namespace swss;
+
+static struct nl_msg *linkMsg(int type, int ifindex, const char *name, uint32_t mtu)
+{
+    struct ifinfomsg ifi = {};
+    ifi.ifi_family = AF_UNSPEC;
+    ifi.ifi_index = ifindex;
+
+    struct nl_msg *msg = nlmsg_alloc_simple(type, 0);
+    nlmsg_set_proto(msg, NETLINK_ROUTE);
+    nlmsg_append(msg, &ifi, sizeof(ifi), NLMSG_ALIGNTO);
+    nla_put_string(msg, IFLA_IFNAME, name);
+    nla_put_u32(msg, IFLA_MTU, mtu);
+    return msg;
+}
+
+static void dispatch(int type, int ifindex, const char *name, uint32_t mtu, const void *source = NULL)
+{
+    struct nl_msg *msg = linkMsg(type, ifindex, name, mtu);
+    NetDispatcher::getInstance().onNetlinkMessage(msg, source);
+    nlmsg_free(msg);
+}
+
+static void dispatchAddr(int type, int ifindex, uint32_t addr)
+{
+    struct ifaddrmsg ifa = {};
+    ifa.ifa_family = AF_INET;
+    ifa.ifa_prefixlen = 32;
+    ifa.ifa_index = static_cast<uint32_t>(ifindex);
+
+    struct nl_msg *msg = nlmsg_alloc_simple(type, 0);
+    nlmsg_set_proto(msg, NETLINK_ROUTE);
+    nlmsg_append(msg, &ifa, sizeof(ifa), NLMSG_ALIGNTO);
+    nla_put_u32(msg, IFA_LOCAL, addr);
+    nla_put_u32(msg, IFA_ADDRESS, addr);
+    NetDispatcher::getInstance().onNetlinkMessage(msg);
+    nlmsg_free(msg);
+}
+
+static void dispatchNeigh(int type, int ifindex, uint32_t addr)
+{
+    struct ndmsg ndm = {};
+    ndm.ndm_family = AF_INET;
+    ndm.ndm_ifindex = ifindex;
+    ndm.ndm_state = NUD_REACHABLE;
+
+    struct nl_msg *msg = nlmsg_alloc_simple(type, 0);
+    nlmsg_set_proto(msg, NETLINK_ROUTE);
+    nlmsg_append(msg, &ndm, sizeof(ndm), NLMSG_ALIGNTO);
+    nla_put_u32(msg, NDA_DST, addr);
+    NetDispatcher::getInstance().onNetlinkMessage(msg);
+    nlmsg_free(msg);
+}
+
+struct LinkEvent
+{
+    int type;
+    int ifindex;
+    uint32_t mtu;
+};
+
+class LinkHandler : public NetMsg, public NetBatchMsg
+{
+public:
+    void onMsg(int nlmsg_type, struct nl_object *obj) override
+    {
+        record(nlmsg_type, obj);
+    }
+
+    void onMsgBatch(int nlmsg_type, const vector<struct nl_object *> &objs) override
+    {
+        batches++;
+        for (auto obj : objs)
+        {
+            record(nlmsg_type, obj);
+        }
+    }
+
+    vector<LinkEvent> events;
+    int batches = 0;
+
+private:
+    void record(int nlmsg_type, struct nl_object *obj)
+    {
+        struct rtnl_link *link = (struct rtnl_link *)obj;
+        events.push_back({ nlmsg_type, rtnl_link_get_ifindex(link), rtnl_link_get_mtu(link) });
+    }
+};
+
+class NetDispatcherTest : public ::testing::Test
+{
+protected:
+    void TearDown() override
+    {
+        NetDispatcher::getInstance().flush();
+        NetDispatcher::getInstance().unregisterMessageHandler(RTM_NEWLINK);
+        NetDispatcher::getInstance().unregisterMessageHandler(RTM_DELLINK);
+        NetDispatcher::getInstance().unregisterMessageHandler(RTM_NEWADDR);
+        NetDispatcher::getInstance().unregisterMessageHandler(RTM_DELADDR);
+        NetDispatcher::getInstance().unregisterMessageHandler(RTM_NEWNEIGH);
+        NetDispatcher::getInstance().unregisterMessageHandler(RTM_DELNEIGH);
+        NetDispatcher::getInstance().setMaxBatchSize(NetDispatcher::DEFAULT_MAX_BATCH_SIZE);
+        NetDispatcher::getInstance().setStateTracking(false);
+    }
+
+    LinkHandler handler;
+};
+
+TEST_F(NetDispatcherTest, per_message)
+{
+    NetDispatcher::getInstance().registerMessageHandler(RTM_NEWLINK, &handler);
+    EXPECT_ANY_THROW(NetDispatcher::getInstance().registerBatchHandler(RTM_NEWLINK, &handler));
+
+    dispatch(RTM_NEWLINK, 1, "Ethernet0", 1500);
+    dispatch(RTM_NEWLINK, 1, "Ethernet0", 9100);
+    dispatch(RTM_DELLINK, 1, "Ethernet0", 9100);
+
+    /* Delivered right away, unregistered types are dropped */
+    ASSERT_EQ(handler.events.size(), (size_t) 2);
+    EXPECT_EQ(handler.events[0].mtu, 1500u);
+    EXPECT_EQ(handler.events[1].mtu, 9100u);
+}
+
+TEST_F(NetDispatcherTest, batch)
+{
+    NetDispatcher::getInstance().registerBatchHandler(RTM_NEWLINK, &handler);
+    NetDispatcher::getInstance().registerBatchHandler(RTM_DELLINK, &handler);
+
+    dispatch(RTM_NEWLINK, 1, "Ethernet0", 1500);
+    dispatch(RTM_NEWLINK, 2, "Ethernet4", 1500);
+    dispatch(RTM_NEWLINK, 1, "Ethernet0", 9100);
+    dispatch(RTM_NEWLINK, 3, "Ethernet8", 1500);
+    dispatch(RTM_DELLINK, 2, "Ethernet4", 1500);
+    EXPECT_TRUE(handler.events.empty());
+
+    NetDispatcher::getInstance().flush();
+
+    /* Last update of each link, grouped by type in arrival order */
+    ASSERT_EQ(handler.events.size(), (size_t) 3);
+    EXPECT_EQ(handler.batches, 2);
+    EXPECT_EQ(handler.events[0].type, RTM_NEWLINK);
+    EXPECT_EQ(handler.events[0].ifindex, 1);
+    EXPECT_EQ(handler.events[0].mtu, 9100u);
+    EXPECT_EQ(handler.events[1].type, RTM_NEWLINK);
+    EXPECT_EQ(handler.events[1].ifindex, 3);
+    EXPECT_EQ(handler.events[2].type, RTM_DELLINK);
+    EXPECT_EQ(handler.events[2].ifindex, 2);
+
+    NetDispatcher::getInstance().flush();
+    EXPECT_EQ(handler.batches, 2);
+}
+
+TEST_F(NetDispatcherTest, mixed)
+{
+    NetDispatcher::getInstance().registerBatchHandler(RTM_NEWLINK, &handler);
+    NetDispatcher::getInstance().registerMessageHandler(RTM_DELLINK, &handler);
+
+    dispatch(RTM_NEWLINK, 1, "Ethernet0", 1500);
+    dispatch(RTM_NEWLINK, 2, "Ethernet4", 1500);
+    EXPECT_TRUE(handler.events.empty());
+
+    /* The pending creation goes first */
+    dispatch(RTM_DELLINK, 1, "Ethernet0", 1500);
+    ASSERT_EQ(handler.events.size(), (size_t) 3);
+    EXPECT_EQ(handler.events[0].type, RTM_NEWLINK);
+    EXPECT_EQ(handler.events[0].ifindex, 1);
+    EXPECT_EQ(handler.events[1].type, RTM_NEWLINK);
+    EXPECT_EQ(handler.events[1].ifindex, 2);
+    EXPECT_EQ(handler.events[2].type, RTM_DELLINK);
+    EXPECT_EQ(handler.events[2].ifindex, 1);
+
+    NetDispatcher::getInstance().flush();
+    EXPECT_EQ(handler.events.size(), (size_t) 3);
+}
+
+TEST_F(NetDispatcherTest, max_batch_size)
+{
+    NetDispatcher::getInstance().registerBatchHandler(RTM_NEWLINK, &handler);
+    NetDispatcher::getInstance().setMaxBatchSize(4);
+
+    int links[] = { 1, 2, 1, 2, 1, 3 };
+    for (int ifindex : links)
+    {
+        dispatch(RTM_NEWLINK, ifindex, "Ethernet", 1500);
+    }
+
+    /* Repeated links do not count towards the size */
+    EXPECT_EQ(handler.batches, 0);
+
+    dispatch(RTM_NEWLINK, 4, "Ethernet", 1500);
+    EXPECT_EQ(handler.batches, 1);
+    EXPECT_EQ(handler.events.size(), (size_t) 4);
+
+    dispatch(RTM_NEWLINK, 1, "Ethernet", 1500);
+    EXPECT_EQ(handler.batches, 1);
+
+    NetDispatcher::getInstance().flush();
+    EXPECT_EQ(handler.batches, 2);
+    EXPECT_EQ(handler.events.size(), (size_t) 5);
+}
+
+TEST_F(NetDispatcherTest, resync)
+{
+    NetDispatcher &dispatcher = NetDispatcher::getInstance();
+    dispatcher.registerMessageHandler(RTM_NEWLINK, &handler);
+    dispatcher.registerMessageHandler(RTM_DELLINK, &handler);
+    dispatcher.setStateTracking(true);
+
+    dispatch(RTM_NEWLINK, 1, "Ethernet0", 1500);
+    dispatch(RTM_NEWLINK, 2, "Ethernet4", 1500);
+    dispatch(RTM_NEWLINK, 3, "Ethernet8", 1500);
+    dispatch(RTM_NEWLINK, 4, "Ethernet12", 1500);
+    dispatch(RTM_DELLINK, 4, "Ethernet12", 1500);
+    ASSERT_EQ(handler.events.size(), (size_t) 5);
+    handler.events.clear();
+
+    /* Outside of a resync, unchanged updates still go through */
+    dispatch(RTM_NEWLINK, 1, "Ethernet0", 1500);
+    EXPECT_EQ(handler.events.size(), (size_t) 1);
+    handler.events.clear();
+
+    /* What a dump returns after Ethernet4 changed and Ethernet8 was removed */
+    dispatcher.beginResync(NULL, { RTM_GETLINK });
+    dispatch(RTM_NEWLINK, 1, "Ethernet0", 1500);
+    dispatch(RTM_NEWLINK, 2, "Ethernet4", 9100);
+    dispatch(RTM_NEWLINK, 5, "Ethernet16", 1500);
+    dispatcher.endResync(NULL);
+
+    ASSERT_EQ(handler.events.size(), (size_t) 3);
+    EXPECT_EQ(handler.events[0].type, RTM_NEWLINK);
+    EXPECT_EQ(handler.events[0].ifindex, 2);
+    EXPECT_EQ(handler.events[0].mtu, 9100u);
+    EXPECT_EQ(handler.events[1].type, RTM_NEWLINK);
+    EXPECT_EQ(handler.events[1].ifindex, 5);
+    EXPECT_EQ(handler.events[2].type, RTM_DELLINK);
+    EXPECT_EQ(handler.events[2].ifindex, 3);
+    EXPECT_EQ(handler.events[2].mtu, 1500u);
+
+    /* Ethernet8 is forgotten */
+    handler.events.clear();
+    dispatcher.beginResync(NULL, { RTM_GETLINK });
+    dispatch(RTM_NEWLINK, 1, "Ethernet0", 1500);
+    dispatch(RTM_NEWLINK, 2, "Ethernet4", 9100);
+    dispatch(RTM_NEWLINK, 5, "Ethernet16", 1500);
+    dispatcher.endResync(NULL);
+    EXPECT_TRUE(handler.events.empty());
+}
+
+TEST_F(NetDispatcherTest, resync_batch)
+{
+    NetDispatcher &dispatcher = NetDispatcher::getInstance();
+    dispatcher.registerBatchHandler(RTM_NEWLINK, &handler);
+    dispatcher.registerBatchHandler(RTM_DELLINK, &handler);
+    dispatcher.setStateTracking(true);
+
+    dispatch(RTM_NEWLINK, 1, "Ethernet0", 1500);
+    dispatch(RTM_NEWLINK, 2, "Ethernet4", 1500);
+    dispatcher.flush();
+    handler.events.clear();
+
+    dispatcher.beginResync(NULL, { RTM_GETLINK });
+    dispatch(RTM_NEWLINK, 1, "Ethernet0", 9100);
+    dispatcher.endResync(NULL);
+
+    ASSERT_EQ(handler.events.size(), (size_t) 2);
+    EXPECT_EQ(handler.events[0].type, RTM_NEWLINK);
+    EXPECT_EQ(handler.events[0].ifindex, 1);
+    EXPECT_EQ(handler.events[1].type, RTM_DELLINK);
+    EXPECT_EQ(handler.events[1].ifindex, 2);
+}
+
+class TypeHandler : public NetMsg
+{
+public:
+    void onMsg(int nlmsg_type, struct nl_object *) override
+    {
+        types.push_back(nlmsg_type);
+    }
+
+    vector<int> types;
+};
+
+TEST_F(NetDispatcherTest, resync_scope)
+{
+    NetDispatcher &dispatcher = NetDispatcher::getInstance();
+    TypeHandler others;
+    dispatcher.registerMessageHandler(RTM_NEWLINK, &handler);
+    dispatcher.registerMessageHandler(RTM_DELLINK, &handler);
+    dispatcher.registerMessageHandler(RTM_NEWADDR, &others);
+    dispatcher.registerMessageHandler(RTM_DELADDR, &others);
+    dispatcher.registerMessageHandler(RTM_NEWNEIGH, &others);
+    dispatcher.registerMessageHandler(RTM_DELNEIGH, &others);
+    dispatcher.setStateTracking(true);
+
+    int source = 0, otherSource = 0;
+    dispatch(RTM_NEWLINK, 1, "Ethernet0", 1500, &source);
+    dispatch(RTM_NEWLINK, 2, "Ethernet4", 1500, &source);
+    dispatch(RTM_NEWLINK, 3, "Ethernet8", 1500, &otherSource);
+    dispatchAddr(RTM_NEWADDR, 1, 0x0100000a);
+    dispatchNeigh(RTM_NEWNEIGH, 1, 0x0200000a);
+    ASSERT_EQ(others.types, vector<int>({ RTM_NEWADDR, RTM_NEWNEIGH }));
+    handler.events.clear();
+    others.types.clear();
+
+    /* A link dump of source only, which no longer has Ethernet4 */
+    dispatcher.beginResync(&source, { RTM_GETLINK });
+    EXPECT_TRUE(dispatcher.isResyncing());
+    dispatch(RTM_NEWLINK, 1, "Ethernet0", 1500, &source);
+    dispatcher.endResync(&source);
+    EXPECT_FALSE(dispatcher.isResyncing());
+
+    /* Addresses, neighbours and links of the other source are not deleted */
+    ASSERT_EQ(handler.events.size(), (size_t) 1);
+    EXPECT_EQ(handler.events[0].type, RTM_DELLINK);
+    EXPECT_EQ(handler.events[0].ifindex, 2);
+    EXPECT_TRUE(others.types.empty());
+
+    /* Still tracked, so a resync of the other source finds Ethernet8 gone */
+    handler.events.clear();
+    dispatcher.beginResync(&otherSource, { RTM_GETLINK });
+    dispatcher.endResync(&otherSource);
+    ASSERT_EQ(handler.events.size(), (size_t) 1);
+    EXPECT_EQ(handler.events[0].ifindex, 3);
+}
+
+TEST_F(NetDispatcherTest, netlink_resync)
+{
+    NetDispatcher &dispatcher = NetDispatcher::getInstance();
+    dispatcher.registerMessageHandler(RTM_NEWLINK, &handler);
+    dispatcher.registerMessageHandler(RTM_DELLINK, &handler);
+    dispatcher.setStateTracking(true);
+
+    Counter &resyncs = MetricsRegistry::getInstance().getCounter("netlink.resyncs");
+    uint64_t before = resyncs.get();
+
+    NetLink netlink;
+    Select s;
+    s.addSelectable(&netlink);
+
+    netlink.dumpRequest(RTM_GETLINK);
+    for (int i = 0; i < 10 && handler.events.empty(); i++)
+    {
+        Selectable *sel;
+        s.select(&sel, 1000);
+    }
+    ASSERT_FALSE(handler.events.empty());
+
+    /* Nothing changed, so nothing is dispatched again */
+    handler.events.clear();
+    netlink.resync();
+    EXPECT_TRUE(netlink.isResyncing());
+    for (int i = 0; i < 10 && netlink.isResyncing(); i++)
+    {
+        Selectable *sel;
+        s.select(&sel, 1000);
+    }
+
+    EXPECT_FALSE(netlink.isResyncing());
+    EXPECT_FALSE(dispatcher.isResyncing());
+    EXPECT_TRUE(handler.events.empty());
+    EXPECT_EQ(resyncs.get(), before + 1);
+}
@@ -75,3 +75,128 @@ TEST(Notifications, test)
     notification_thread->join();
 }
 //FIXME: no tests inside
+
+static void sendPacked(int count, int keys)
+{
+    swss::DBConnector dbNtf(ASIC_DB, "localhost", 6379, 0);
+    swss::RedisPipeline pipeline(&dbNtf);
+    swss::NotificationProducer notifications(&pipeline, "NOTIFICATIONS", true);
+
+    /* Single packed message, consumer gets all notifications at once */
+    notifications.setPackSize(count);
+
+    for (int i = 0; i < count; i++)
+    {
+        std::vector<swss::FieldValueTuple> entry = { { "seq", std::to_string(i) } };
+
+        notifications.send("ntf", std::to_string(i % keys), entry);
+    }
+
+    notifications.flush();
+}
+
+TEST(Notifications, queue_limit_drop)
+{
+    swss::DBConnector dbNtf(ASIC_DB, "localhost", 6379, 0);
+    swss::NotificationConsumer consumer(&dbNtf, "NOTIFICATIONS");
+    consumer.setQueueLimit(10);
+
+    swss::Select s;
+    s.addSelectable(&consumer);
+
+    sendPacked(100, 100);
+
+    swss::Selectable *sel;
+    EXPECT_EQ(s.select(&sel, 2000), swss::Select::OBJECT);
+
+    EXPECT_EQ(consumer.getQueueSize(), 10U);
+    EXPECT_EQ(consumer.getDroppedCount(), 90U);
+
+    std::deque<swss::KeyOpFieldsValuesTuple> vkco;
+    consumer.pops(vkco);
+
+    EXPECT_EQ(vkco.size(), 10U);
+    EXPECT_EQ(consumer.getQueueSize(), 0U);
+
+    for (size_t i = 0; i < vkco.size(); i++)
+    {
+        EXPECT_EQ(kfvOp(vkco[i]), "ntf");
+        EXPECT_EQ(kfvKey(vkco[i]), std::to_string(90 + i));
+    }
+}
+
+TEST(Notifications, queue_limit_coalesce)
+{
+    swss::DBConnector dbNtf(ASIC_DB, "localhost", 6379, 0);
+    swss::NotificationConsumer consumer(&dbNtf, "NOTIFICATIONS");
+    consumer.setQueueLimit(10, swss::NotificationConsumer::COALESCE);
+
+    swss::Select s;
+    s.addSelectable(&consumer);
+
+    sendPacked(100, 5);
+
+    swss::Selectable *sel;
+    EXPECT_EQ(s.select(&sel, 2000), swss::Select::OBJECT);
+
+    EXPECT_EQ(consumer.getQueueSize(), 5U);
+    EXPECT_EQ(consumer.getCoalescedCount(), 95U);
+    EXPECT_EQ(consumer.getDroppedCount(), 0U);
+
+    std::deque<swss::KeyOpFieldsValuesTuple> vkco;
+    consumer.pops(vkco);
+
+    EXPECT_EQ(vkco.size(), 5U);
+
+    for (size_t i = 0; i < vkco.size(); i++)
+    {
+        EXPECT_EQ(kfvKey(vkco[i]), std::to_string(i));
+
+        /* Latest notification for each data wins */
+        auto &values = kfvFieldsValues(vkco[i]);
+        EXPECT_EQ(values.size(), 1U);
+        EXPECT_EQ(fvValue(values.at(0)), std::to_string(95 + i));
+    }
+}
+
+TEST(Notifications, queue_limit_coalesce_order)
+{
+    swss::DBConnector dbNtf(ASIC_DB, "localhost", 6379, 0);
+    swss::NotificationConsumer consumer(&dbNtf, "NOTIFICATIONS");
+    consumer.setQueueLimit(10, swss::NotificationConsumer::COALESCE);
+
+    swss::Select s;
+    s.addSelectable(&consumer);
+
+    {
+        swss::RedisPipeline pipeline(&dbNtf);
+        swss::NotificationProducer notifications(&pipeline, "NOTIFICATIONS", true);
+        notifications.setPackSize(4);
+
+        std::vector<swss::FieldValueTuple> entry = { { "seq", "1" } };
+        notifications.send("SET", "k", entry);
+        std::vector<swss::FieldValueTuple> none;
+        notifications.send("DEL", "k", none);
+        entry = { { "seq", "2" } };
+        notifications.send("SET", "k", entry);
+        entry = { { "seq", "3" } };
+        notifications.send("SET", "k", entry);
+        notifications.flush();
+    }
+
+    swss::Selectable *sel;
+    EXPECT_EQ(s.select(&sel, 2000), swss::Select::OBJECT);
+
+    /* Only the last SET merges, the first one must stay before the DEL */
+    EXPECT_EQ(consumer.getCoalescedCount(), 1U);
+
+    std::deque<swss::KeyOpFieldsValuesTuple> vkco;
+    consumer.pops(vkco);
+
+    ASSERT_EQ(vkco.size(), 3U);
+    EXPECT_EQ(kfvOp(vkco[0]), "SET");
+    EXPECT_EQ(fvValue(kfvFieldsValues(vkco[0]).at(0)), "1");
+    EXPECT_EQ(kfvOp(vkco[1]), "DEL");
+    EXPECT_EQ(kfvOp(vkco[2]), "SET");
+    EXPECT_EQ(fvValue(kfvFieldsValues(vkco[2]).at(0)), "3");
+}
@@ -0,0 +1,196 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <linux/if.h>
+
+#include "gtest/gtest.h"
+#include "common/rawnetdispatcher.h"
+#include "common/rawnetlink.h"
+#include "common/select.h"
+
+using namespace std;
+using namespace swss;
+
+static void addAttr(vector<char> &msg, unsigned short type, const void *data, size_t len)
+{
+    struct rtattr attr;
+    attr.rta_type = type;
+    attr.rta_len = static_cast<unsigned short>(RTA_LENGTH(len));
+
+    size_t offset = msg.size();
+    msg.resize(offset + RTA_SPACE(len), 0);
+    memcpy(&msg[offset], &attr, sizeof(attr));
+    memcpy(&msg[offset + RTA_LENGTH(0)], data, len);
+}
+
+static void appendLinkMsg(vector<char> &buf, uint16_t type, int ifindex, const string &name, uint32_t mtu)
+{
+    vector<char> msg(NLMSG_SPACE(sizeof(struct ifinfomsg)), 0);
+    addAttr(msg, IFLA_IFNAME, name.c_str(), name.size() + 1);
+    addAttr(msg, IFLA_MTU, &mtu, sizeof(mtu));
+
+    auto hdr = reinterpret_cast<struct nlmsghdr *>(msg.data());
+    hdr->nlmsg_len = static_cast<uint32_t>(msg.size());
+    hdr->nlmsg_type = type;
+    reinterpret_cast<struct ifinfomsg *>(NLMSG_DATA(hdr))->ifi_index = ifindex;
+
+    buf.insert(buf.end(), msg.begin(), msg.end());
+}
+
+class RawLinkHandler : public RawNetMsg
+{
+public:
+    void onMsg(const struct nlmsghdr *msg) override
+    {
+        auto ifi = netlinkHeader<struct ifinfomsg>(msg);
+        ASSERT_NE(ifi, nullptr);
+
+        auto attrs = NetlinkAttrs<IFLA_MAX>::parse<struct ifinfomsg>(msg);
+        const char *name = attrs.getString(IFLA_IFNAME);
+
+        ifindexes.push_back(ifi->ifi_index);
+        names.push_back(name ? name : "");
+        mtus.push_back(attrs.getValue<uint32_t>(IFLA_MTU));
+    }
+
+    void onOverrun() override
+    {
+        overruns++;
+    }
+
+    vector<int> ifindexes;
+    vector<string> names;
+    vector<uint32_t> mtus;
+    int overruns = 0;
+};
+
+TEST(RawNetDispatcher, dispatch)
+{
+    RawLinkHandler handler;
+    RawNetDispatcher::getInstance().registerMessageHandler(RTM_NEWLINK, &handler);
+    EXPECT_ANY_THROW(RawNetDispatcher::getInstance().registerMessageHandler(RTM_NEWLINK, &handler));
+
+    vector<char> buf;
+    appendLinkMsg(buf, RTM_NEWLINK, 1, "Ethernet0", 9100);
+    appendLinkMsg(buf, RTM_DELLINK, 2, "Ethernet4", 1500);
+    appendLinkMsg(buf, RTM_NEWLINK, 3, "Ethernet8", 1500);
+
+    /* Truncated last message is dropped */
+    size_t complete = buf.size();
+    appendLinkMsg(buf, RTM_NEWLINK, 4, "Ethernet12", 1500);
+    RawNetDispatcher::getInstance().onNetlinkMessages(buf.data(), complete + 8);
+
+    RawNetDispatcher::getInstance().unregisterMessageHandler(RTM_NEWLINK);
+
+    ASSERT_EQ(handler.ifindexes, vector<int>({ 1, 3 }));
+    EXPECT_EQ(handler.names, vector<string>({ "Ethernet0", "Ethernet8" }));
+    EXPECT_EQ(handler.mtus, vector<uint32_t>({ 9100, 1500 }));
+}
+
+TEST(RawNetDispatcher, unaligned)
+{
+    RawLinkHandler handler;
+    RawNetDispatcher::getInstance().registerMessageHandler(RTM_NEWLINK, &handler);
+
+    vector<char> buf;
+    appendLinkMsg(buf, RTM_NEWLINK, 1, "Ethernet0", 9100);
+
+    /* Last message ending with a 5 bytes attribute, without its padding */
+    size_t offset = buf.size();
+    vector<char> last(NLMSG_SPACE(sizeof(struct ifinfomsg)), 0);
+    addAttr(last, IFLA_IFNAME, "eth1", 5);
+    auto hdr = reinterpret_cast<struct nlmsghdr *>(last.data());
+    hdr->nlmsg_len = static_cast<uint32_t>(last.size() - 3);
+    hdr->nlmsg_type = RTM_NEWLINK;
+    buf.insert(buf.end(), last.begin(), last.begin() + hdr->nlmsg_len);
+
+    /* Exactly sized, so that reading past the end is caught */
+    vector<char> exact(buf.begin(), buf.end());
+    exact.shrink_to_fit();
+    ASSERT_EQ(exact.size(), offset + NLMSG_SPACE(sizeof(struct ifinfomsg)) + RTA_LENGTH(5));
+    RawNetDispatcher::getInstance().onNetlinkMessages(exact.data(), exact.size());
+
+    RawNetDispatcher::getInstance().unregisterMessageHandler(RTM_NEWLINK);
+
+    EXPECT_EQ(handler.names, vector<string>({ "Ethernet0", "eth1" }));
+}
+
+TEST(RawNetDispatcher, overrun)
+{
+    RawLinkHandler links, other;
+    RawNetDispatcher &dispatcher = RawNetDispatcher::getInstance();
+    dispatcher.registerMessageHandler(RTM_NEWLINK, &links);
+    dispatcher.registerMessageHandler(RTM_DELLINK, &links);
+    dispatcher.registerMessageHandler(RTM_NEWADDR, &other);
+
+    dispatcher.onOverrun();
+
+    dispatcher.unregisterMessageHandler(RTM_NEWLINK);
+    dispatcher.unregisterMessageHandler(RTM_DELLINK);
+    dispatcher.unregisterMessageHandler(RTM_NEWADDR);
+
+    /* Once per handler, whatever the number of types it handles */
+    EXPECT_EQ(links.overruns, 1);
+    EXPECT_EQ(other.overruns, 1);
+
+    dispatcher.onOverrun();
+    EXPECT_EQ(links.overruns, 1);
+}
+
+TEST(RawNetDispatcher, attrs)
+{
+    vector<char> buf;
+    appendLinkMsg(buf, RTM_NEWLINK, 1, "Ethernet0", 9100);
+    auto msg = reinterpret_cast<struct nlmsghdr *>(buf.data());
+
+    /* Types above MAX are not indexed */
+    auto small = NetlinkAttrs<IFLA_IFNAME>::parse<struct ifinfomsg>(msg);
+    EXPECT_STREQ(small.getString(IFLA_IFNAME), "Ethernet0");
+    EXPECT_FALSE(small.has(IFLA_MTU));
+    EXPECT_EQ(small.getValue<uint32_t>(IFLA_MTU, 42), 42u);
+
+    /* Not NUL terminated */
+    vector<char> bad(NLMSG_SPACE(sizeof(struct ifinfomsg)), 0);
+    addAttr(bad, IFLA_IFNAME, "eth", 3);
+    auto badMsg = reinterpret_cast<struct nlmsghdr *>(bad.data());
+    badMsg->nlmsg_len = static_cast<uint32_t>(bad.size());
+    EXPECT_EQ(NetlinkAttrs<IFLA_MAX>::parse<struct ifinfomsg>(badMsg).getString(IFLA_IFNAME), nullptr);
+
+    /* An attribute overrunning the message stops the parsing */
+    msg->nlmsg_len -= 4;
+    auto truncated = NetlinkAttrs<IFLA_MAX>::parse<struct ifinfomsg>(msg);
+    EXPECT_TRUE(truncated.has(IFLA_IFNAME));
+    EXPECT_FALSE(truncated.has(IFLA_MTU));
+
+    /* Nested */
+    vector<char> nested;
+    uint32_t value = 7;
+    addAttr(nested, 1, &value, sizeof(value));
+    vector<char> outer;
+    addAttr(outer, IFLA_LINKINFO | NLA_F_NESTED, nested.data(), nested.size());
+    auto inner = NetlinkAttrs<4>::parseNested(reinterpret_cast<struct rtattr *>(outer.data()));
+    EXPECT_EQ(inner.getValue<uint32_t>(1), 7u);
+}
+
+TEST(RawNetLink, dump)
+{
+    RawLinkHandler handler;
+    RawNetDispatcher::getInstance().registerMessageHandler(RTM_NEWLINK, &handler);
+
+    RawNetLink netlink;
+    netlink.dumpRequest(RTM_GETLINK);
+
+    Select s;
+    s.addSelectable(&netlink);
+
+    /* The loopback interface is always there */
+    for (int i = 0; i < 10 && handler.names.empty(); i++)
+    {
+        Selectable *sel;
+        s.select(&sel, 1000);
+    }
+
+    RawNetDispatcher::getInstance().unregisterMessageHandler(RTM_NEWLINK);
+
+    EXPECT_NE(find(handler.names.begin(), handler.names.end(), "lo"), handler.names.end());
+}
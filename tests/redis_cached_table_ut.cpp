@@ -0,0 +1,153 @@
+#include <string>
+#include <vector>
+#include <map>
+#include "gtest/gtest.h"
+#include "common/dbconnector.h"
+#include "common/select.h"
+#include "common/table.h"
+#include "common/cachedtable.h"
+
+using namespace std;
+using namespace swss;
+
+#define TEST_DB           APPL_DB
+#define NUMBER_OF_KEYS      (100)
+
+static const string testTableName = "UT_CACHED_TABLE";
+
+static inline string key(int i)
+{
+    return string("key") + to_string(i);
+}
+
+static inline void clearDB()
+{
+    DBConnector db(TEST_DB, "localhost", 6379, 0);
+    RedisReply r(&db, "FLUSHALL", REDIS_REPLY_STATUS);
+    r.checkStatusOK();
+}
+
+static void fill(Table &t)
+{
+    for (int i = 0; i < NUMBER_OF_KEYS; i++)
+    {
+        vector<FieldValueTuple> fields;
+        fields.push_back(FieldValueTuple("field", to_string(i)));
+        t.set(key(i), fields);
+    }
+}
+
+/* Wait for the keyspace event of a write done by another client */
+static void waitEvent(CachedTable &c)
+{
+    Select s;
+    Selectable *sel;
+    s.addSelectable(&c);
+
+    int ret = s.select(&sel, 1000);
+    EXPECT_EQ(ret, Select::OBJECT);
+}
+
+TEST(CachedTable, get)
+{
+    clearDB();
+
+    DBConnector db(TEST_DB, "localhost", 6379, 0);
+    Table p(&db, testTableName);
+    fill(p);
+
+    CachedTable c(&db, testTableName);
+    EXPECT_EQ(c.size(), (size_t)NUMBER_OF_KEYS);
+
+    vector<string> keys;
+    c.getKeys(keys);
+    EXPECT_EQ(keys.size(), (size_t)NUMBER_OF_KEYS);
+
+    vector<FieldValueTuple> values;
+    for (int i = 0; i < NUMBER_OF_KEYS; i++)
+    {
+        EXPECT_TRUE(c.get(key(i), values));
+        ASSERT_EQ(values.size(), 1U);
+        EXPECT_EQ(fvValue(values[0]), to_string(i));
+    }
+    EXPECT_FALSE(c.get("nokey", values));
+
+    EXPECT_EQ(c.getHits(), (uint64_t)NUMBER_OF_KEYS + 1);
+    EXPECT_EQ(c.getMisses(), 0U);
+
+    /* Changes by another client */
+    vector<FieldValueTuple> fields;
+    fields.push_back(FieldValueTuple("field", "new"));
+    p.set(key(0), fields);
+    waitEvent(c);
+
+    EXPECT_TRUE(c.get(key(0), values));
+    ASSERT_EQ(values.size(), 1U);
+    EXPECT_EQ(fvValue(values[0]), "new");
+    EXPECT_EQ(c.getMisses(), 1U);
+
+    p.del(key(1));
+    waitEvent(c);
+    EXPECT_FALSE(c.get(key(1), values));
+
+    p.set("newkey", fields);
+    waitEvent(c);
+    EXPECT_TRUE(c.get("newkey", values));
+
+    /* Own writes */
+    c.del(key(2));
+    EXPECT_FALSE(c.get(key(2), values));
+    c.set(key(3), fields);
+    EXPECT_TRUE(c.get(key(3), values));
+    ASSERT_EQ(values.size(), 1U);
+    EXPECT_EQ(fvValue(values[0]), "new");
+}
+
+TEST(CachedTable, max_entries)
+{
+    clearDB();
+
+    DBConnector db(TEST_DB, "localhost", 6379, 0);
+    Table p(&db, testTableName);
+    fill(p);
+
+    CachedTable c(&db, testTableName, NUMBER_OF_KEYS / 2);
+    EXPECT_EQ(c.size(), (size_t)NUMBER_OF_KEYS / 2);
+
+    vector<string> keys;
+    c.getKeys(keys);
+    EXPECT_EQ(keys.size(), (size_t)NUMBER_OF_KEYS);
+
+    /* Every key is readable, the cache never grows past its limit */
+    vector<FieldValueTuple> values;
+    for (int i = 0; i < NUMBER_OF_KEYS; i++)
+    {
+        EXPECT_TRUE(c.get(key(i), values));
+        EXPECT_EQ(fvValue(values[0]), to_string(i));
+    }
+    EXPECT_EQ(c.size(), (size_t)NUMBER_OF_KEYS / 2);
+    EXPECT_GT(c.getMisses(), 0U);
+    EXPECT_FALSE(c.get("nokey", values));
+}
+
+TEST(CachedTable, non_hash_key)
+{
+    clearDB();
+
+    DBConnector db(TEST_DB, "localhost", 6379, 0);
+    Table p(&db, testTableName);
+    fill(p);
+
+    /* Matches the SCAN pattern but HGETALL fails with WRONGTYPE */
+    RedisReply r(&db, "SET " + p.getKeyName("string") + " value", REDIS_REPLY_STATUS);
+
+    CachedTable c(&db, testTableName);
+    EXPECT_EQ(c.size(), (size_t)NUMBER_OF_KEYS);
+
+    /* The connection is still in sync */
+    vector<FieldValueTuple> values;
+    EXPECT_TRUE(c.get(key(0), values));
+    EXPECT_TRUE(p.get(key(1), values));
+    ASSERT_EQ(values.size(), 1U);
+    EXPECT_EQ(fvValue(values[0]), "1");
+}
@@ -12,6 +12,12 @@
 #include "common/table.h"
 #include "common/producerstatetable.h"
 #include "common/consumerstatetable.h"
+#include "common/shardedproducerstatetable.h"
+#include "common/shardedconsumerstatetable.h"
+#include "common/orderedproducerstatetable.h"
+#include "common/orderedconsumerstatetable.h"
+#include "common/producertable.h"
+#include "common/consumertable.h"
 
 using namespace std;
 using namespace swss;
@@ -351,6 +357,358 @@ TEST(ConsumerStateTable, async_set_del_set)
     }
 }
 
+TEST(ConsumerStateTable, async_coalesce)
+{
+    clearDB();
+
+    /* Prepare producer */
+    int index = 0;
+    string tableName = "UT_REDIS_THREAD_" + to_string(index);
+    DBConnector db(TEST_DB, "localhost", 6379, 0);
+    RedisPipeline pipeline(&db);
+    ProducerStateTable p(&pipeline, tableName, true);
+    p.setCoalescing(true);
+
+    /* Successive sets are merged field by field */
+    {
+        vector<FieldValueTuple> fields;
+        fields.push_back(FieldValueTuple(field(0), value(0)));
+        fields.push_back(FieldValueTuple(field(1), value(1)));
+        p.set("key0", fields);
+    }
+    {
+        vector<FieldValueTuple> fields;
+        fields.push_back(FieldValueTuple(field(1), value(3)));
+        fields.push_back(FieldValueTuple(field(2), value(2)));
+        p.set("key0", fields);
+    }
+
+    /* Only the fields of the set following a del are left */
+    {
+        vector<FieldValueTuple> fields;
+        fields.push_back(FieldValueTuple(field(0), value(0)));
+        p.set("key1", fields);
+        p.del("key1");
+        fields.clear();
+        fields.push_back(FieldValueTuple(field(1), value(1)));
+        p.set("key1", fields);
+    }
+
+    EXPECT_EQ(p.getCoalescedCount(), 3U);
+    EXPECT_EQ(pipeline.size(), 0U);
+    p.flush();
+
+    /* Prepare consumer */
+    ConsumerStateTable c(&db, tableName);
+    Select cs;
+    Selectable *selectcs;
+    cs.addSelectable(&c);
+
+    int ret = cs.select(&selectcs);
+    EXPECT_EQ(ret, Select::OBJECT);
+
+    std::deque<KeyOpFieldsValuesTuple> vkco;
+    c.pops(vkco);
+    EXPECT_EQ(vkco.size(), 2U);
+
+    for (auto &kco: vkco)
+    {
+        EXPECT_EQ(kfvOp(kco), "SET");
+
+        map<string, string> mm;
+        for (auto fv: kfvFieldsValues(kco))
+        {
+            mm[fvField(fv)] = fvValue(fv);
+        }
+
+        if (kfvKey(kco) == "key0")
+        {
+            EXPECT_EQ(mm.size(), 3U);
+            EXPECT_EQ(mm[field(0)], value(0));
+            EXPECT_EQ(mm[field(1)], value(3));
+            EXPECT_EQ(mm[field(2)], value(2));
+        }
+        else
+        {
+            EXPECT_EQ(kfvKey(kco), "key1");
+            EXPECT_EQ(mm.size(), 1U);
+            EXPECT_EQ(mm[field(1)], value(1));
+        }
+    }
+}
+
+TEST(ConsumerStateTable, async_transaction)
+{
+    clearDB();
+
+    /* Prepare producers sharing a pipeline */
+    DBConnector db(TEST_DB, "localhost", 6379, 0);
+    RedisPipeline pipeline(&db);
+    ProducerStateTable p0(&pipeline, "UT_REDIS_THREAD_0", true);
+    ProducerStateTable p1(&pipeline, "UT_REDIS_THREAD_1", true);
+
+    vector<FieldValueTuple> fields;
+    fields.push_back(FieldValueTuple(field(0), value(0)));
+
+    p0.multi();
+    p0.set("key0", fields);
+    p1.set("key1", fields);
+    p0.exec();
+
+    /* Nothing sent before EXEC, MULTI and two queued commands */
+    EXPECT_EQ(pipeline.size(), 4U);
+    p0.flush();
+    EXPECT_EQ(pipeline.size(), 0U);
+
+    ConsumerStateTable c0(&db, "UT_REDIS_THREAD_0");
+    ConsumerStateTable c1(&db, "UT_REDIS_THREAD_1");
+
+    KeyOpFieldsValuesTuple kco;
+    c0.pop(kco);
+    EXPECT_EQ(kfvKey(kco), "key0");
+    EXPECT_EQ(kfvOp(kco), "SET");
+    c1.pop(kco);
+    EXPECT_EQ(kfvKey(kco), "key1");
+    EXPECT_EQ(kfvOp(kco), "SET");
+}
+
+TEST(ConsumerStateTable, sharded)
+{
+    clearDB();
+
+    const int shards = 4;
+    string tableName = "UT_REDIS_THREAD_0";
+    DBConnector db(TEST_DB, "localhost", 6379, 0);
+    RedisPipeline pipeline(&db);
+    ShardedProducerStateTable p(&pipeline, tableName, shards, true);
+    EXPECT_EQ(p.getShardCount(), shards);
+
+    for (int i = 0; i < NUMBER_OF_OPS; i++)
+    {
+        vector<FieldValueTuple> fields;
+        fields.push_back(FieldValueTuple(field(0), value(i)));
+        p.set(key(i), fields);
+    }
+    p.flush();
+
+    /* Drain every shard from its own thread and connection */
+    vector<int> popped(shards, 0);
+    vector<thread> consumers;
+    for (int s = 0; s < shards; s++)
+    {
+        consumers.emplace_back([&, s]() {
+            DBConnector cdb(TEST_DB, "localhost", 6379, 0);
+            ShardedConsumerStateTable c(&cdb, tableName, s);
+            EXPECT_EQ(c.getShard(), s);
+
+            std::deque<KeyOpFieldsValuesTuple> vkco;
+            do
+            {
+                c.pops(vkco);
+                for (auto &kco: vkco)
+                {
+                    EXPECT_EQ(TableName_KeySet::getShard(kfvKey(kco), shards), s);
+                    EXPECT_EQ(kfvOp(kco), "SET");
+                }
+                popped[s] += (int)vkco.size();
+            }
+            while (!vkco.empty());
+        });
+    }
+
+    int total = 0;
+    for (int s = 0; s < shards; s++)
+    {
+        consumers[s].join();
+        EXPECT_GT(popped[s], 0);
+        total += popped[s];
+    }
+    EXPECT_EQ(total, NUMBER_OF_OPS);
+}
+
+TEST(ConsumerStateTable, ordered)
+{
+    clearDB();
+
+    string tableName = "UT_REDIS_THREAD_0";
+    DBConnector db(TEST_DB, "localhost", 6379, 0);
+    OrderedProducerStateTable p(&db, tableName);
+
+    vector<FieldValueTuple> fields;
+    fields.push_back(FieldValueTuple(field(0), value(0)));
+
+    /* Bulk entries in FIFO order, even within the same millisecond */
+    p.set("key2", fields);
+    p.set("key1", fields);
+    p.del("key0");
+
+    /* Then an urgent one */
+    p.setPriority(10);
+    p.set("key3", fields);
+
+    /* Already waiting, keeps its place */
+    p.setPriority(0);
+    p.set("key2", fields);
+
+    EXPECT_THROW(p.setPriority(OrderedProducerStateTable::MAX_PRIORITY + 1), invalid_argument);
+
+    OrderedConsumerStateTable c(&db, tableName);
+    Select cs;
+    Selectable *selectcs;
+    cs.addSelectable(&c);
+    int ret = cs.select(&selectcs);
+    EXPECT_EQ(ret, Select::OBJECT);
+
+    std::deque<KeyOpFieldsValuesTuple> vkco;
+    c.pops(vkco);
+    ASSERT_EQ(vkco.size(), 4U);
+    EXPECT_EQ(kfvKey(vkco[0]), "key3");
+    EXPECT_EQ(kfvKey(vkco[1]), "key2");
+    EXPECT_EQ(kfvKey(vkco[2]), "key1");
+    EXPECT_EQ(kfvKey(vkco[3]), "key0");
+    EXPECT_EQ(kfvOp(vkco[3]), "DEL");
+
+    c.pops(vkco);
+    EXPECT_TRUE(vkco.empty());
+}
+
+TEST(ConsumerStateTable, coalesced_destroy)
+{
+    clearDB();
+
+    const int shards = 4;
+    string tableName = "UT_REDIS_THREAD_0";
+    string orderedTableName = "UT_REDIS_THREAD_1";
+    DBConnector db(TEST_DB, "localhost", 6379, 0);
+
+    vector<FieldValueTuple> fields;
+    fields.push_back(FieldValueTuple(field(0), value(0)));
+
+    /* Destroyed with coalesced entries pending, they must reach the
+     * key sets of the derived tables */
+    {
+        ShardedProducerStateTable p(&db, tableName, shards);
+        p.setCoalescing(true);
+        OrderedProducerStateTable o(&db, orderedTableName);
+        o.setCoalescing(true);
+
+        for (int i = 0; i < 10; i++)
+        {
+            p.set(key(i), fields);
+            o.set(key(i), fields);
+        }
+    }
+
+    int total = 0;
+    for (int s = 0; s < shards; s++)
+    {
+        ShardedConsumerStateTable c(&db, tableName, s);
+        std::deque<KeyOpFieldsValuesTuple> vkco;
+        c.pops(vkco);
+        total += (int)vkco.size();
+    }
+    EXPECT_EQ(total, 10);
+
+    OrderedConsumerStateTable c(&db, orderedTableName);
+    std::deque<KeyOpFieldsValuesTuple> vkco;
+    c.pops(vkco);
+    ASSERT_EQ(vkco.size(), 10U);
+    EXPECT_EQ(kfvKey(vkco[0]), key(0));
+    EXPECT_EQ(kfvKey(vkco[9]), key(9));
+
+    /* Nothing went to the unsharded key set */
+    ConsumerStateTable u(&db, tableName);
+    u.pops(vkco);
+    EXPECT_TRUE(vkco.empty());
+}
+
+TEST(ConsumerStateTable, tracing)
+{
+    clearDB();
+
+    string tableName = "UT_REDIS_THREAD_0";
+    DBConnector db(TEST_DB, "localhost", 6379, 0);
+    ProducerStateTable p(&db, tableName);
+    p.setTracing(true);
+
+    vector<FieldValueTuple> fields;
+    fields.push_back(FieldValueTuple(field(0), value(0)));
+    for (int i = 0; i < 10; i++)
+    {
+        p.set(key(i), fields);
+    }
+    p.del(key(10));
+
+    ConsumerStateTable c(&db, tableName);
+    const Histogram &latency = c.getLatencyHistogram();
+    uint64_t traced = latency.getCount();
+
+    std::deque<KeyOpFieldsValuesTuple> vkco;
+    c.pops(vkco);
+    ASSERT_EQ(vkco.size(), 11U);
+    for (auto &kco: vkco)
+    {
+        EXPECT_EQ(kfvFieldsValues(kco).size(), kfvOp(kco) == SET_COMMAND ? 1U : 0U);
+    }
+
+    EXPECT_EQ(latency.getCount() - traced, 11U);
+    EXPECT_LT(latency.getMax(), 10000000U);
+
+    /* Traces never reach the table and are gone once popped */
+    Table t(&db, tableName);
+    vector<FieldValueTuple> values;
+    ASSERT_TRUE(t.get(key(0), values));
+    ASSERT_EQ(values.size(), 1U);
+    EXPECT_EQ(fvField(values[0]), field(0));
+    RedisReply exists(&db, "EXISTS " + c.getKeySetTraceName(), REDIS_REPLY_INTEGER);
+    EXPECT_EQ(exists.getContext()->integer, 0);
+
+    /* Untraced writes to a traced key are not sampled */
+    p.setTracing(false);
+    p.set(key(0), fields);
+    c.pops(vkco);
+    ASSERT_EQ(vkco.size(), 1U);
+    EXPECT_EQ(latency.getCount() - traced, 11U);
+}
+
+TEST(ConsumerTable, tracing)
+{
+    clearDB();
+
+    string tableName = "UT_REDIS_THREAD_0";
+    DBConnector db(TEST_DB, "localhost", 6379, 0);
+    ProducerTable p(&db, tableName);
+    p.setTracing(true);
+
+    vector<FieldValueTuple> fields;
+    fields.push_back(FieldValueTuple(field(0), value(0)));
+    p.set(key(0), fields);
+    p.set(key(1), fields);
+    p.del(key(1));
+
+    ConsumerTable c(&db, tableName);
+    const Histogram &latency = c.getLatencyHistogram();
+    uint64_t traced = latency.getCount();
+
+    std::deque<KeyOpFieldsValuesTuple> vkco;
+    c.pops(vkco);
+    ASSERT_EQ(vkco.size(), 3U);
+    EXPECT_EQ(kfvOp(vkco[0]), SET_COMMAND);
+    ASSERT_EQ(kfvFieldsValues(vkco[0]).size(), 1U);
+    EXPECT_EQ(fvField(kfvFieldsValues(vkco[0])[0]), field(0));
+    EXPECT_EQ(kfvOp(vkco[2]), DEL_COMMAND);
+    EXPECT_TRUE(kfvFieldsValues(vkco[2]).empty());
+    EXPECT_EQ(latency.getCount() - traced, 3U);
+
+    /* The pops script writes the entry without its trace */
+    Table t(&db, tableName);
+    vector<FieldValueTuple> values;
+    ASSERT_TRUE(t.get(key(0), values));
+    ASSERT_EQ(values.size(), 1U);
+    EXPECT_EQ(fvField(values[0]), field(0));
+    EXPECT_FALSE(t.get(key(1), values));
+}
+
 TEST(ConsumerStateTable, async_singlethread)
 {
     clearDB();
@@ -284,6 +284,76 @@ TEST(DBConnector, piped_notifications)
     EXPECT_EQ(value, 2);
 }
 
+static void bufferedNotificationProducer(size_t packSize)
+{
+    sleep(1);
+
+    DBConnector db(TEST_DB, "localhost", 6379, 0);
+    RedisPipeline pipeline(&db);
+    NotificationProducer np(&pipeline, "UT_REDIS_CHANNEL", true);
+    np.setPackSize(packSize);
+
+    for (int i = 0; i < NUMBER_OF_OPS; i++)
+    {
+        vector<FieldValueTuple> values;
+        FieldValueTuple tuple(field(i), value(i));
+        values.push_back(tuple);
+
+        np.send("op", to_string(i), values);
+    }
+
+    np.flush();
+}
+
+static void testBufferedNotifications(size_t packSize)
+{
+    DBConnector db(TEST_DB, "localhost", 6379, 0);
+    NotificationConsumer nc(&db, "UT_REDIS_CHANNEL");
+    Select s;
+    s.addSelectable(&nc);
+    Selectable *sel;
+    int collected = 0;
+
+    clearDB();
+
+    thread np(bufferedNotificationProducer, packSize);
+
+    while (collected < NUMBER_OF_OPS)
+    {
+        int result = s.select(&sel, 2000);
+        if (result != Select::OBJECT)
+        {
+            break;
+        }
+
+        string op, data;
+        vector<FieldValueTuple> values;
+
+        nc.pop(op, data, values);
+
+        EXPECT_EQ(op, "op");
+        EXPECT_EQ(data, to_string(collected));
+        EXPECT_EQ(values.size(), 1U);
+        EXPECT_EQ(fvField(values.at(0)), field(collected));
+        EXPECT_EQ(fvValue(values.at(0)), value(collected));
+
+        collected++;
+    }
+
+    np.join();
+    EXPECT_EQ(collected, NUMBER_OF_OPS);
+}
+
+TEST(DBConnector, piped_notifications_buffered)
+{
+    testBufferedNotifications(0);
+}
+
+TEST(DBConnector, piped_notifications_packed)
+{
+    testBufferedNotifications(16);
+}
+
 static void selectableEventThread(Selectable *ev, int *value)
 {
     Select s;
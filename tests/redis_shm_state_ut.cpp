@@ -0,0 +1,292 @@
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <algorithm>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "gtest/gtest.h"
+#include "common/dbconnector.h"
+#include "common/select.h"
+#include "common/table.h"
+#include "common/shmring.h"
+#include "common/shmproducerstatetable.h"
+#include "common/shmconsumerstatetable.h"
+#include "common/consumerstatetable.h"
+
+using namespace std;
+using namespace swss;
+
+#define TEST_DB           APPL_DB
+#define NUMBER_OF_OPS      (1000)
+
+static inline string key(int i)
+{
+    return string("key") + to_string(i);
+}
+
+static inline void clearDB()
+{
+    DBConnector db(TEST_DB, "localhost", 6379, 0);
+    RedisReply r(&db, "FLUSHALL", REDIS_REPLY_STATUS);
+    r.checkStatusOK();
+}
+
+static inline void removeRing(const string &name)
+{
+    unlink((string(ShmRing::SHM_RING_DIR) + "/swss_ring_" + name).c_str());
+}
+
+TEST(ShmRing, push_pop)
+{
+    removeRing("UT_RING");
+
+    /* Small ring so that it wraps around several times */
+    ShmRing consumer("UT_RING", ShmRing::CONSUMER, 4096);
+    ShmRing producer("UT_RING", ShmRing::PRODUCER);
+
+    EXPECT_TRUE(producer.isActive());
+    EXPECT_TRUE(consumer.empty());
+
+    for (int round = 0; round < 100; round++)
+    {
+        int pushed = 0;
+        while (producer.push(KeyOpFieldsValuesTuple(key(pushed), SET_COMMAND, { { "field", to_string(pushed) }, { "empty", "" } })))
+        {
+            pushed++;
+        }
+
+        EXPECT_GT(pushed, 0);
+
+        KeyOpFieldsValuesTuple kco;
+        for (int i = 0; i < pushed; i++)
+        {
+            EXPECT_TRUE(consumer.pop(kco));
+            EXPECT_EQ(kfvKey(kco), key(i));
+            EXPECT_EQ(kfvOp(kco), SET_COMMAND);
+            EXPECT_EQ(kfvFieldsValues(kco).size(), 2U);
+            EXPECT_EQ(fvValue(kfvFieldsValues(kco)[0]), to_string(i));
+            EXPECT_EQ(fvValue(kfvFieldsValues(kco)[1]), "");
+        }
+
+        EXPECT_FALSE(consumer.pop(kco));
+        EXPECT_TRUE(consumer.empty());
+    }
+
+    /* Only one producer owns the ring */
+    ShmRing second("UT_RING", ShmRing::PRODUCER);
+    EXPECT_FALSE(second.isActive());
+    EXPECT_FALSE(second.push(KeyOpFieldsValuesTuple("key", DEL_COMMAND, {})));
+}
+
+TEST(ShmRing, no_consumer)
+{
+    removeRing("UT_RING");
+
+    ShmRing producer("UT_RING", ShmRing::PRODUCER);
+    EXPECT_FALSE(producer.push(KeyOpFieldsValuesTuple("key", DEL_COMMAND, {})));
+}
+
+TEST(ShmRing, reclaim)
+{
+    removeRing("UT_RING");
+
+    ShmRing producer("UT_RING", ShmRing::PRODUCER);
+    vector<string> keys;
+    EXPECT_FALSE(producer.reclaim(keys));
+
+    int attached[2], done[2];
+    ASSERT_EQ(pipe(attached), 0);
+    ASSERT_EQ(pipe(done), 0);
+
+    pid_t pid = fork();
+    ASSERT_NE(pid, -1);
+    if (pid == 0)
+    {
+        /* Consumer which dies without detaching */
+        ShmRing consumer("UT_RING", ShmRing::CONSUMER);
+        char c = 0;
+        if (write(attached[1], &c, 1) != 1 || read(done[0], &c, 1) != 1)
+        {
+            _exit(1);
+        }
+        _exit(0);
+    }
+
+    char c;
+    ASSERT_EQ(read(attached[0], &c, 1), 1);
+
+    EXPECT_TRUE(producer.push(KeyOpFieldsValuesTuple(key(0), "", {})));
+    EXPECT_TRUE(producer.push(KeyOpFieldsValuesTuple(key(1), "", {})));
+
+    /* Consumer is alive, its records stay */
+    EXPECT_FALSE(producer.reclaim(keys));
+
+    ASSERT_EQ(write(done[1], &c, 1), 1);
+    int status;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+
+    EXPECT_TRUE(producer.reclaim(keys));
+    ASSERT_EQ(keys.size(), 2U);
+    EXPECT_EQ(keys[0], key(0));
+    EXPECT_EQ(keys[1], key(1));
+    EXPECT_FALSE(producer.push(KeyOpFieldsValuesTuple(key(2), "", {})));
+
+    keys.clear();
+    EXPECT_FALSE(producer.reclaim(keys));
+
+    /* A new consumer finds an empty ring */
+    ShmRing consumer("UT_RING", ShmRing::CONSUMER);
+    EXPECT_TRUE(consumer.empty());
+
+    for (int fd: { attached[0], attached[1], done[0], done[1] })
+    {
+        close(fd);
+    }
+}
+
+static int consume(ShmConsumerStateTable &c, int count)
+{
+    Select cs;
+    Selectable *selectcs;
+    int collected = 0;
+
+    cs.addSelectable(&c);
+    while (collected < count && cs.select(&selectcs, 2000) == Select::OBJECT)
+    {
+        deque<KeyOpFieldsValuesTuple> vkco;
+        c.pops(vkco);
+
+        for (const auto &kco: vkco)
+        {
+            EXPECT_EQ(kfvKey(kco), key(collected % NUMBER_OF_OPS));
+            collected++;
+        }
+    }
+
+    return collected;
+}
+
+TEST(ShmConsumerStateTable, set_del)
+{
+    clearDB();
+
+    string tableName = "UT_REDIS_SHM";
+    removeRing(to_string(TEST_DB) + "_" + tableName);
+
+    DBConnector db(TEST_DB, "localhost", 6379, 0);
+    ShmConsumerStateTable c(&db, tableName);
+
+    RedisPipeline pipeline(&db);
+    ShmProducerStateTable p(&pipeline, tableName, true);
+
+    for (int i = 0; i < NUMBER_OF_OPS; i++)
+    {
+        p.set(key(i), { { "field", "value" } });
+    }
+    p.flush();
+
+    EXPECT_EQ(consume(c, NUMBER_OF_OPS), NUMBER_OF_OPS);
+
+    /* Redis still has the content */
+    Table t(&db, tableName);
+    vector<string> keys;
+    t.getKeys(keys);
+    EXPECT_EQ(keys.size(), (size_t)NUMBER_OF_OPS);
+
+    for (int i = 0; i < NUMBER_OF_OPS; i++)
+    {
+        p.del(key(i));
+    }
+    p.flush();
+
+    EXPECT_EQ(consume(c, NUMBER_OF_OPS), NUMBER_OF_OPS);
+
+    t.getKeys(keys);
+    EXPECT_TRUE(keys.empty());
+}
+
+TEST(ShmConsumerStateTable, fallback)
+{
+    clearDB();
+
+    string tableName = "UT_REDIS_SHM";
+    removeRing(to_string(TEST_DB) + "_" + tableName);
+
+    DBConnector db(TEST_DB, "localhost", 6379, 0);
+
+    /* No consumer attached yet, entries go through the key set */
+    ShmProducerStateTable p(&db, tableName);
+    for (int i = 0; i < NUMBER_OF_OPS; i++)
+    {
+        p.set(key(i), { { "field", "value" } });
+    }
+
+    ShmConsumerStateTable c(&db, tableName);
+
+    Select cs;
+    Selectable *selectcs;
+    cs.addSelectable(&c);
+
+    int collected = 0;
+    while (collected < NUMBER_OF_OPS && cs.select(&selectcs, 2000) == Select::OBJECT)
+    {
+        deque<KeyOpFieldsValuesTuple> vkco;
+        c.pops(vkco);
+        collected += (int)vkco.size();
+    }
+
+    EXPECT_EQ(collected, NUMBER_OF_OPS);
+}
+
+TEST(ShmConsumerStateTable, merged_fields)
+{
+    clearDB();
+
+    string tableName = "UT_REDIS_SHM";
+    removeRing(to_string(TEST_DB) + "_" + tableName);
+
+    DBConnector db(TEST_DB, "localhost", 6379, 0);
+    ShmConsumerStateTable c(&db, tableName);
+    ShmProducerStateTable p(&db, tableName);
+
+    p.set(key(0), { { "a", "1" } });
+    p.set(key(0), { { "b", "2" } });
+
+    /* Same entry a ConsumerStateTable would see, with both fields */
+    deque<KeyOpFieldsValuesTuple> vkco;
+    c.pops(vkco);
+    ASSERT_EQ(vkco.size(), 1U);
+    EXPECT_EQ(kfvKey(vkco[0]), key(0));
+    EXPECT_EQ(kfvOp(vkco[0]), SET_COMMAND);
+    EXPECT_EQ(kfvFieldsValues(vkco[0]).size(), 2U);
+
+    p.del(key(0));
+    c.pops(vkco);
+    ASSERT_EQ(vkco.size(), 1U);
+    EXPECT_EQ(kfvOp(vkco[0]), DEL_COMMAND);
+}
+
+TEST(ShmConsumerStateTable, detach)
+{
+    clearDB();
+
+    string tableName = "UT_REDIS_SHM";
+    removeRing(to_string(TEST_DB) + "_" + tableName);
+
+    DBConnector db(TEST_DB, "localhost", 6379, 0);
+    ShmProducerStateTable p(&db, tableName);
+
+    {
+        ShmConsumerStateTable c(&db, tableName);
+        for (int i = 0; i < 10; i++)
+        {
+            p.set(key(i), { { "field", "value" } });
+        }
+    }
+
+    /* Unread records were moved to the key set */
+    ConsumerStateTable c(&db, tableName);
+    deque<KeyOpFieldsValuesTuple> vkco;
+    c.pops(vkco);
+    EXPECT_EQ(vkco.size(), 10U);
+}
@@ -0,0 +1,156 @@
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <algorithm>
+#include "gtest/gtest.h"
+#include "common/dbconnector.h"
+#include "common/select.h"
+#include "common/table.h"
+#include "common/producerstreamtable.h"
+#include "common/consumerstreamtable.h"
+
+using namespace std;
+using namespace swss;
+
+#define TEST_DB           APPL_DB
+#define NUMBER_OF_OPS      (1000)
+#define MAX_FIELDS_DIV       (30) // Testing up to 30 fields objects
+
+static inline int getMaxFields(int i)
+{
+    return (i/MAX_FIELDS_DIV) + 1;
+}
+
+static inline string key(int i)
+{
+    return string("key") + to_string(i);
+}
+
+static inline string field(int i)
+{
+    return string("field") + to_string(i);
+}
+
+static inline string value(int i)
+{
+    if (i == 0) return string(); // emtpy
+    return string("value") + to_string(i);
+}
+
+static inline void clearDB()
+{
+    DBConnector db(TEST_DB, "localhost", 6379, 0);
+    RedisReply r(&db, "FLUSHALL", REDIS_REPLY_STATUS);
+    r.checkStatusOK();
+}
+
+static void produce(ProducerStreamTable &p)
+{
+    for (int i = 0; i < NUMBER_OF_OPS; i++)
+    {
+        vector<FieldValueTuple> fields;
+        for (int j = 0; j < getMaxFields(i); j++)
+        {
+            FieldValueTuple t(field(j), value(j));
+            fields.push_back(t);
+        }
+
+        p.set(key(i), fields);
+    }
+
+    for (int i = 0; i < NUMBER_OF_OPS; i++)
+    {
+        p.del(key(i));
+    }
+
+    p.flush();
+}
+
+static int consume(ConsumerStreamTable &c, int count)
+{
+    Select cs;
+    Selectable *selectcs;
+    int collected = 0;
+
+    cs.addSelectable(&c);
+    while (collected < count && cs.select(&selectcs, 2000) == Select::OBJECT)
+    {
+        deque<KeyOpFieldsValuesTuple> vkco;
+        c.pops(vkco);
+
+        for (const auto &kco: vkco)
+        {
+            /* Stream keeps the producer order */
+            int i = collected % NUMBER_OF_OPS;
+            EXPECT_EQ(kfvKey(kco), key(i));
+
+            if (collected < NUMBER_OF_OPS)
+            {
+                EXPECT_EQ(kfvOp(kco), SET_COMMAND);
+                EXPECT_EQ(kfvFieldsValues(kco).size(), (size_t)getMaxFields(i));
+            }
+            else
+            {
+                EXPECT_EQ(kfvOp(kco), DEL_COMMAND);
+                EXPECT_TRUE(kfvFieldsValues(kco).empty());
+            }
+
+            collected++;
+        }
+    }
+
+    return collected;
+}
+
+TEST(ConsumerStreamTable, set_del)
+{
+    clearDB();
+
+    string tableName = "UT_REDIS_STREAM";
+    DBConnector db(TEST_DB, "localhost", 6379, 0);
+    ConsumerStreamTable c(&db, tableName);
+
+    RedisPipeline pipeline(&db);
+    ProducerStreamTable p(&pipeline, tableName, true);
+    produce(p);
+
+    EXPECT_EQ(consume(c, NUMBER_OF_OPS * 2), NUMBER_OF_OPS * 2);
+    c.ack();
+
+    RedisReply r(&db, "XLEN " + c.getStreamName(), REDIS_REPLY_INTEGER);
+    EXPECT_EQ(r.getReply<long long int>(), 0);
+}
+
+TEST(ConsumerStreamTable, restart)
+{
+    clearDB();
+
+    string tableName = "UT_REDIS_STREAM";
+    DBConnector db(TEST_DB, "localhost", 6379, 0);
+
+    /* Entries written before the consumer exists are not lost */
+    ProducerStreamTable p(&db, tableName);
+    produce(p);
+
+    {
+        /* Read the first batch but never acknowledge it */
+        ConsumerStreamTable c(&db, tableName);
+        Select cs;
+        Selectable *selectcs;
+        cs.addSelectable(&c);
+        EXPECT_EQ(cs.select(&selectcs, 2000), Select::OBJECT);
+
+        deque<KeyOpFieldsValuesTuple> vkco;
+        c.pops(vkco);
+        EXPECT_FALSE(vkco.empty());
+    }
+
+    /* Restarted consumer gets all unacknowledged entries again */
+    ConsumerStreamTable c(&db, tableName);
+    EXPECT_EQ(consume(c, NUMBER_OF_OPS * 2), NUMBER_OF_OPS * 2);
+    c.ack();
+
+    /* And nothing once they are acknowledged */
+    ConsumerStreamTable c2(&db, tableName);
+    EXPECT_EQ(consume(c2, 1), 0);
+}
@@ -12,6 +12,7 @@
 #include "common/selectableevent.h"
 #include "common/selectabletimer.h"
 #include "common/table.h"
+#include "common/redistran.h"
 
 using namespace std;
 using namespace swss;
@@ -444,6 +445,41 @@ TEST(DBConnector, selectabletimer)
     ASSERT_EQ(sel, &timer);
 }
 
+TEST(RedisTransactioner, pipelined)
+{
+    clearDB();
+
+    DBConnector db(TEST_DB, "localhost", 6379, 0);
+    RedisTransactioner t(&db);
+
+    t.multi();
+    t.enqueue("SET ut_tran_key 1", REDIS_REPLY_STATUS);
+    t.enqueue("INCR ut_tran_key", REDIS_REPLY_INTEGER);
+    t.enqueue("GET ut_tran_key", REDIS_REPLY_STRING);
+    EXPECT_TRUE(t.exec());
+
+    RedisReply(t.dequeueReply()).checkStatusOK();
+    EXPECT_EQ(RedisReply(t.dequeueReply()).getReply<long long int>(), 2);
+    EXPECT_EQ(RedisReply(t.dequeueReply()).getReply<string>(), "2");
+
+    /* Async variant */
+    t.multi();
+    t.enqueue("INCR ut_tran_key", REDIS_REPLY_INTEGER);
+    t.execAsync();
+    EXPECT_TRUE(t.waitExec());
+    EXPECT_EQ(RedisReply(t.dequeueReply()).getReply<long long int>(), 3);
+
+    /* A command rejected while queued fails the transaction... */
+    t.multi();
+    t.enqueue("INCR ut_tran_key", REDIS_REPLY_INTEGER);
+    t.enqueue("NOSUCHCOMMAND", REDIS_REPLY_STATUS);
+    EXPECT_THROW(t.exec(), system_error);
+
+    /* ... and leaves the connection usable */
+    RedisReply r(&db, "GET ut_tran_key", REDIS_REPLY_STRING);
+    EXPECT_EQ(r.getReply<string>(), "3");
+}
+
 TEST(Table, basic)
 {
     TableBasicTest("TABLE_UT_TEST");
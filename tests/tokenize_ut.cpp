@@ -4,6 +4,9 @@
 
 #include "gtest/gtest.h"
 
+#include <random>
+#include <sstream>
+
 using namespace std;
 using namespace swss;
 
@@ -115,3 +118,83 @@ TEST(TOKENIZEFISRT, not_found)
 
     EXPECT_EQ(tokens_2[0], key_2);
 }
+
+/* What tokenize() did before Tokenizer */
+static vector<string> referenceTokenize(const string &str, char token)
+{
+    string tmp;
+    vector<string> ret;
+    istringstream iss(str);
+
+    while (getline(iss, tmp, token))
+        ret.push_back(tmp);
+
+    return ret;
+}
+
+static vector<string> referenceTokenize(const string &str, char token, size_t firstN)
+{
+    vector<string> ret;
+    string tmp = str;
+    size_t i = 0;
+    auto pos = tmp.find(token);
+
+    while (pos != string::npos && i++ < firstN)
+    {
+        ret.push_back(tmp.substr(0, pos));
+        tmp = tmp.substr(pos+1);
+        pos = tmp.find(token);
+    }
+
+    ret.push_back(tmp);
+
+    return ret;
+}
+
+TEST(TOKENIZER, basic)
+{
+    string key("PORT_TABLE:Ethernet0::");
+    Tokenizer tokens(key, ':');
+    const char *begin;
+    size_t len;
+
+    ASSERT_TRUE(tokens.next(begin, len));
+    EXPECT_EQ(string(begin, len), "PORT_TABLE");
+    EXPECT_EQ(begin, key.data());
+    ASSERT_TRUE(tokens.next(begin, len));
+    EXPECT_EQ(string(begin, len), "Ethernet0");
+    ASSERT_TRUE(tokens.next(begin, len));
+    EXPECT_EQ(len, (size_t) 0);
+    EXPECT_FALSE(tokens.next(begin, len));
+    EXPECT_FALSE(tokens.next(begin, len));
+
+    Tokenizer empty("", 0, ':');
+    EXPECT_FALSE(empty.next(begin, len));
+}
+
+TEST(TOKENIZER, IP_invalid)
+{
+    EXPECT_THROW(IpAddresses("192.168.0.1,192.168.0"), invalid_argument);
+    EXPECT_THROW(IpAddresses("192.168.0.1,,192.168.0.2"), invalid_argument);
+}
+
+TEST(TOKENIZER, reference)
+{
+    mt19937 gen(1);
+    const char alphabet[] = "ab::";
+
+    for (int i = 0; i < 10000; i++)
+    {
+        string s;
+        size_t len = gen() % 10;
+        for (size_t j = 0; j < len; j++)
+        {
+            s += alphabet[gen() % (sizeof(alphabet) - 1)];
+        }
+
+        EXPECT_EQ(tokenize(s, ':'), referenceTokenize(s, ':')) << s;
+
+        size_t firstN = gen() % 5;
+        EXPECT_EQ(tokenize(s, ':', firstN), referenceTokenize(s, ':', firstN)) << s;
+    }
+}
@@ -0,0 +1,74 @@
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "common/histogram.h"
+#include "common/tracing.h"
+
+using namespace std;
+using namespace swss;
+
+TEST(Histogram, buckets)
+{
+    for (uint64_t v = 0; v < 100000; v++)
+    {
+        int b = Histogram::getBucket(v);
+        EXPECT_LT(b, Histogram::BUCKETS);
+        EXPECT_GE(Histogram::getBucketUpperBound(b), v);
+        if (b > 0)
+        {
+            EXPECT_LT(Histogram::getBucketUpperBound(b - 1), v);
+        }
+    }
+
+    EXPECT_EQ(Histogram::getBucket(UINT64_MAX), Histogram::BUCKETS - 1);
+    EXPECT_EQ(Histogram::getBucketUpperBound(Histogram::BUCKETS - 1), UINT64_MAX);
+}
+
+TEST(Histogram, percentiles)
+{
+    Histogram h;
+    EXPECT_EQ(h.getPercentile(50), 0U);
+
+    for (uint64_t v = 1; v <= 1000; v++)
+    {
+        h.record(v);
+    }
+
+    EXPECT_EQ(h.getCount(), 1000U);
+    EXPECT_EQ(h.getSum(), 500500U);
+    EXPECT_EQ(h.getMax(), 1000U);
+
+    /* Within the 12.5% bucket precision */
+    EXPECT_GE(h.getPercentile(50), 500U);
+    EXPECT_LE(h.getPercentile(50), 563U);
+    EXPECT_GE(h.getPercentile(99), 990U);
+    EXPECT_LE(h.getPercentile(99), 1000U);
+    EXPECT_EQ(h.getPercentile(100), 1000U);
+
+    h.reset();
+    EXPECT_EQ(h.getCount(), 0U);
+    EXPECT_EQ(h.getMax(), 0U);
+}
+
+TEST(Tracing, parse)
+{
+    uint64_t latency;
+    string traceId;
+    EXPECT_FALSE(Tracing::parse("", latency, traceId));
+    EXPECT_FALSE(Tracing::parse("value", latency, traceId));
+    EXPECT_FALSE(Tracing::parse(":1.1", latency, traceId));
+    EXPECT_FALSE(Tracing::parse("1x:1.1", latency, traceId));
+
+    string trace = Tracing::make();
+    EXPECT_TRUE(Tracing::parse(trace, latency, traceId));
+    EXPECT_LT(latency, 1000000U);
+    EXPECT_EQ(traceId, trace.substr(trace.find(':') + 1));
+
+    /* Traces are carried after the op of ProducerTable */
+    EXPECT_EQ(trace.find(Tracing::OP_SEPARATOR), string::npos);
+
+    /* Trace ids are unique */
+    string otherId;
+    EXPECT_TRUE(Tracing::parse(Tracing::make(), latency, otherId));
+    EXPECT_NE(otherId, traceId);
+}